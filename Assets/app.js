@@ -18,6 +18,7 @@
   const midiChannelSelectBindings = [];
 
   let midiBlinkUntil = 0;
+  let midiBlinkTimer = null;
 
   const backend = window.__JUCE__ && window.__JUCE__.backend ? window.__JUCE__.backend : null;
 
@@ -26,12 +27,19 @@
   const midiInputDot = document.getElementById("midiInputDot");
   const midiInputText = document.getElementById("midiInputText");
 
+  const spectrumGridCanvas = document.getElementById("spectrumGridCanvas");
   const spectrumCanvas = document.getElementById("spectrumCanvas");
-  const spectrumCtx = spectrumCanvas.getContext("2d");
 
   const crossoverOverlay = document.getElementById("crossoverOverlay");
   const crossoverLines = Array.from(document.querySelectorAll(".crossover-line"));
 
+  const diagnosticsToggle = document.getElementById("diagnosticsToggle");
+  const diagnosticsPanel = document.getElementById("diagnosticsPanel");
+  const diagnosticsSummary = document.getElementById("diagnosticsSummary");
+  const diagnosticsRows = document.getElementById("diagnosticsRows");
+  const diagnosticsReset = document.getElementById("diagnosticsReset");
+  const governorToggle = document.getElementById("governorToggle");
+
   const bandTemplate = document.getElementById("bandTemplate");
   const bandGrid = document.getElementById("bandGrid");
 
@@ -104,6 +112,14 @@
 
     midiInputDot.classList.toggle("active", active);
     midiInputText.textContent = active ? "MIDI input detected" : "MIDI idle";
+
+    // The blink is turned off by a one-shot timer instead of being polled every frame.
+    if (active && midiBlinkTimer === null) {
+      midiBlinkTimer = window.setTimeout(() => {
+        midiBlinkTimer = null;
+        updateMidiIndicator();
+      }, midiBlinkUntil - now + 1);
+    }
   }
 
   function freqToNorm(freq) {
@@ -129,28 +145,66 @@
     return `${Math.round(value)} Hz`;
   }
 
-  function emitParamChange(parameterID, value) {
-    const numericValue = Number(value);
-    state.params[parameterID] = numericValue;
+  // Pointer moves can fire many times per frame; only the latest value per parameter is
+  // sent, once per animation frame, as a single batch the backend applies atomically.
+  const pendingParamUpdates = new Map();
+  let paramFlushScheduled = false;
+
+  function flushParamUpdates() {
+    paramFlushScheduled = false;
+
+    if (pendingParamUpdates.size === 0) {
+      return;
+    }
+
+    const updates = Array.from(pendingParamUpdates, ([id, value]) => ({ id, value }));
+    pendingParamUpdates.clear();
 
     if (backend) {
       backend.emitEvent("paramChange", {
-        id: parameterID,
-        value: numericValue
+        updates
       });
     }
   }
 
+  function queueParamUpdate(parameterID, value) {
+    pendingParamUpdates.set(parameterID, value);
+
+    if (!paramFlushScheduled) {
+      paramFlushScheduled = true;
+      window.requestAnimationFrame(flushParamUpdates);
+    }
+  }
+
+  function emitParamChange(parameterID, value) {
+    const numericValue = Number(value);
+    state.params[parameterID] = numericValue;
+    queueParamUpdate(parameterID, numericValue);
+  }
+
   function emitParamBatch(updates) {
     updates.forEach((update) => {
-      state.params[update.id] = Number(update.value);
+      const numericValue = Number(update.value);
+      state.params[update.id] = numericValue;
+      queueParamUpdate(update.id, numericValue);
     });
+  }
 
-    if (backend) {
-      backend.emitEvent("paramChange", {
-        updates
-      });
+  function emitGesture(parameterIDs, phase) {
+    if (phase === "end") {
+      flushParamUpdates();
     }
+
+    if (!backend) {
+      return;
+    }
+
+    parameterIDs.forEach((parameterID) => {
+      backend.emitEvent("paramGesture", {
+        id: parameterID,
+        phase
+      });
+    });
   }
 
   function registerSetter(paramID, setter) {
@@ -195,6 +249,7 @@
 
     select.addEventListener("change", () => {
       emitParamChange(paramID, Number(select.value));
+      flushParamUpdates();
     });
 
     registerSetter(paramID, (value) => {
@@ -203,6 +258,25 @@
     });
   }
 
+  function createVoiceModeSelect(select, paramID) {
+    ["Mono", "Poly Max", "Poly Sum"].forEach((label, index) => {
+      const option = document.createElement("option");
+      option.value = String(index);
+      option.textContent = label;
+      select.appendChild(option);
+    });
+
+    select.addEventListener("change", () => {
+      emitParamChange(paramID, Number(select.value));
+      flushParamUpdates();
+    });
+
+    registerSetter(paramID, (value) => {
+      state.params[paramID] = Number(value);
+      select.value = String(Math.round(Number(value)));
+    });
+  }
+
   function createKnob(parent, label, paramID, config) {
     const wrap = document.createElement("div");
     wrap.className = "knob-wrap";
@@ -270,11 +344,21 @@
       applyValue(nextValue, true);
     }
 
+    function endDrag() {
+      if (!dragging) {
+        return;
+      }
+
+      dragging = false;
+      emitGesture([paramID], "end");
+    }
+
     hit.addEventListener("pointerdown", (event) => {
       dragging = true;
       dragStartY = event.clientY;
       dragStartValue = Number(state.params[paramID] ?? config.defaultValue);
       hit.setPointerCapture(event.pointerId);
+      emitGesture([paramID], "begin");
       event.preventDefault();
     });
 
@@ -287,13 +371,8 @@
       updateFromDelta(deltaY);
     });
 
-    hit.addEventListener("pointerup", () => {
-      dragging = false;
-    });
-
-    hit.addEventListener("pointercancel", () => {
-      dragging = false;
-    });
+    hit.addEventListener("pointerup", endDrag);
+    hit.addEventListener("pointercancel", endDrag);
 
     hit.addEventListener("wheel", (event) => {
       event.preventDefault();
@@ -312,6 +391,7 @@
 
   function createCurveEditor(canvas, bandIndex) {
     const ctx = canvas.getContext("2d");
+    const gestureIDs = [bandParamId(bandIndex, "releaseMs"), bandParamId(bandIndex, "curveShape")];
     let dragging = false;
 
     function getParams() {
@@ -418,9 +498,19 @@
       refreshBoundControls([bandParamId(bandIndex, "releaseMs"), bandParamId(bandIndex, "curveShape")]);
     }
 
+    function endDrag() {
+      if (!dragging) {
+        return;
+      }
+
+      dragging = false;
+      emitGesture(gestureIDs, "end");
+    }
+
     canvas.addEventListener("pointerdown", (event) => {
       dragging = true;
       canvas.setPointerCapture(event.pointerId);
+      emitGesture(gestureIDs, "begin");
       updateFromPointer(event);
     });
 
@@ -431,13 +521,8 @@
       updateFromPointer(event);
     });
 
-    canvas.addEventListener("pointerup", () => {
-      dragging = false;
-    });
-
-    canvas.addEventListener("pointercancel", () => {
-      dragging = false;
-    });
+    canvas.addEventListener("pointerup", endDrag);
+    canvas.addEventListener("pointercancel", endDrag);
 
     return { draw };
   }
@@ -452,7 +537,7 @@
   }
 
   function redrawCurves() {
-    curveEditors.forEach((editor) => editor.draw());
+    requestRender({ curves: true });
   }
 
   function buildBandPanels() {
@@ -466,6 +551,9 @@
       const midiChannelID = bandParamId(bandIndex, "midiChannel");
       createMidiChannelSelect(channelSelect, midiChannelID);
 
+      const voiceModeSelect = card.querySelector('select[data-param="voiceMode"]');
+      createVoiceModeSelect(voiceModeSelect, bandParamId(bandIndex, "voiceMode"));
+
       const knobs = card.querySelector('[data-grid="knobs"]');
 
       createKnob(knobs, "Depth", bandParamId(bandIndex, "depthDb"), {
@@ -566,6 +654,7 @@
       line.addEventListener("pointerdown", (event) => {
         draggingParam = line.dataset.param;
         line.setPointerCapture(event.pointerId);
+        emitGesture([draggingParam], "begin");
       });
     });
 
@@ -591,15 +680,83 @@
       updateCrossoverLines();
     }
 
-    window.addEventListener("pointermove", updateByPointer);
-    window.addEventListener("pointerup", () => {
+    function endDrag() {
+      if (!draggingParam) {
+        return;
+      }
+
+      emitGesture([draggingParam], "end");
       draggingParam = null;
+    }
+
+    window.addEventListener("pointermove", updateByPointer);
+    window.addEventListener("pointerup", endDrag);
+    window.addEventListener("pointercancel", endDrag);
+  }
+
+  function setDiagnosticsOpen(open) {
+    diagnosticsPanel.hidden = !open;
+    diagnosticsToggle.setAttribute("aria-expanded", open ? "true" : "false");
+
+    // The processor only times its stages while the panel is open.
+    if (backend) {
+      backend.emitEvent("diagnosticsPanel", { open });
+    }
+  }
+
+  function setupDiagnosticsPanel() {
+    diagnosticsToggle.addEventListener("click", () => {
+      setDiagnosticsOpen(diagnosticsPanel.hidden);
     });
-    window.addEventListener("pointercancel", () => {
-      draggingParam = null;
+
+    diagnosticsReset.addEventListener("click", () => {
+      if (backend) {
+        backend.emitEvent("resetProfiling", {});
+      }
+    });
+
+    governorToggle.addEventListener("change", () => {
+      emitParamChange("governor.enabled", governorToggle.checked ? 1 : 0);
+      flushParamUpdates();
+    });
+
+    registerSetter("governor.enabled", (value) => {
+      governorToggle.checked = Number(value) >= 0.5;
     });
   }
 
+  function applyProfilingSnapshot(payload) {
+    if (!payload || !Array.isArray(payload.stages) || diagnosticsPanel.hidden) {
+      return;
+    }
+
+    const formatUs = (value) => (Number(value) || 0).toFixed(1);
+    const overruns = Number(payload.deadlineOverruns) || 0;
+    const worstLoad = (Number(payload.worstDeadlineLoad) || 0) * 100;
+
+    const memory = payload.memory && typeof payload.memory === "object" ? payload.memory : null;
+    const ownedBytes = memory
+      ? (Number(memory.instanceBytes) || 0) + (Number(memory.scratchBytes) || 0) + (Number(memory.heapBytes) || 0)
+      : 0;
+    const footprint = memory
+      ? ` · ${(ownedBytes / 1024).toFixed(0)} KiB + ${((Number(memory.sharedDesignBytes) || 0) / 1024).toFixed(0)} KiB shared designs`
+      : "";
+    const governor = payload.governor && payload.governor.enabled ? ` · governor ${payload.governor.level}` : "";
+    diagnosticsSummary.textContent = `${payload.blocks} blocks · worst ${worstLoad.toFixed(0)}% of deadline · ${overruns} overruns${footprint}${governor}`;
+    diagnosticsSummary.classList.toggle("overrun", overruns > 0);
+
+    diagnosticsRows.replaceChildren(...payload.stages.map((stage) => {
+      const row = document.createElement("tr");
+      [String(stage.name), formatUs(stage.meanUs), formatUs(stage.p50Us), formatUs(stage.p99Us), formatUs(stage.maxUs)]
+        .forEach((text) => {
+          const cell = document.createElement("td");
+          cell.textContent = text;
+          row.appendChild(cell);
+        });
+      return row;
+    }));
+  }
+
   function applyMidiStatus(payload) {
     if (!payload || typeof payload !== "object") {
       return;
@@ -656,84 +813,303 @@
   function handleFFT(payload) {
     if (payload && Array.isArray(payload.bins)) {
       state.fftBins = payload.bins.map((value) => Number(value));
+      requestRender({ spectrum: true });
     }
   }
 
-  function drawSpectrum() {
-    const rect = spectrumCanvas.getBoundingClientRect();
+  // Rendering is demand-driven: nothing is drawn unless new FFT data, a parameter edit or a
+  // resize has marked a layer dirty, and all dirty layers are drawn together in one frame.
+  const dirty = { grid: true, spectrum: true, curves: true };
+  let renderScheduled = false;
+
+  function requestRender(layers) {
+    Object.keys(layers).forEach((layer) => {
+      dirty[layer] = dirty[layer] || layers[layer];
+    });
+
+    if (!renderScheduled) {
+      renderScheduled = true;
+      window.requestAnimationFrame(renderFrame);
+    }
+  }
+
+  function renderFrame() {
+    renderScheduled = false;
+
+    if (dirty.grid) {
+      dirty.grid = false;
+      drawSpectrumGrid();
+    }
+
+    if (dirty.spectrum) {
+      dirty.spectrum = false;
+      spectrumRenderer.draw(state.fftBins);
+    }
+
+    if (dirty.curves) {
+      dirty.curves = false;
+      curveEditors.forEach((editor) => editor.draw());
+    }
+  }
+
+  function sizeCanvasToDisplay(canvas) {
+    const rect = canvas.getBoundingClientRect();
     const dpr = window.devicePixelRatio || 1;
 
     const width = Math.max(1, Math.floor(rect.width * dpr));
     const height = Math.max(1, Math.floor(rect.height * dpr));
 
-    if (spectrumCanvas.width !== width || spectrumCanvas.height !== height) {
-      spectrumCanvas.width = width;
-      spectrumCanvas.height = height;
+    if (canvas.width !== width || canvas.height !== height) {
+      canvas.width = width;
+      canvas.height = height;
     }
 
-    spectrumCtx.setTransform(dpr, 0, 0, dpr, 0, 0);
-    spectrumCtx.clearRect(0, 0, rect.width, rect.height);
+    return { w: rect.width, h: rect.height, dpr };
+  }
+
+  function dbToNorm(db) {
+    return (clamp(db, DB_MIN, DB_MAX) - DB_MIN) / (DB_MAX - DB_MIN);
+  }
+
+  // Static background + grid on its own canvas; only redrawn when the size changes.
+  function drawSpectrumGrid() {
+    const ctx = spectrumGridCanvas.getContext("2d");
+    const { w, h, dpr } = sizeCanvasToDisplay(spectrumGridCanvas);
 
-    const w = rect.width;
-    const h = rect.height;
+    ctx.setTransform(dpr, 0, 0, dpr, 0, 0);
+    ctx.clearRect(0, 0, w, h);
 
-    spectrumCtx.fillStyle = "rgba(6, 14, 18, 0.7)";
-    spectrumCtx.fillRect(0, 0, w, h);
+    ctx.fillStyle = "rgba(6, 14, 18, 0.7)";
+    ctx.fillRect(0, 0, w, h);
 
-    spectrumCtx.strokeStyle = "rgba(255, 255, 255, 0.1)";
-    spectrumCtx.lineWidth = 1;
+    ctx.strokeStyle = "rgba(255, 255, 255, 0.1)";
+    ctx.lineWidth = 1;
 
     const frequencyLines = [20, 40, 80, 160, 320, 640, 1250, 2500, 5000, 10000, 20000];
     frequencyLines.forEach((frequency) => {
       const x = freqToNorm(frequency) * w;
-      spectrumCtx.beginPath();
-      spectrumCtx.moveTo(x, 0);
-      spectrumCtx.lineTo(x, h);
-      spectrumCtx.stroke();
+      ctx.beginPath();
+      ctx.moveTo(x, 0);
+      ctx.lineTo(x, h);
+      ctx.stroke();
     });
 
     for (let db = -90; db <= 0; db += 15) {
-      const y = h - ((db - DB_MIN) / (DB_MAX - DB_MIN)) * h;
-      spectrumCtx.beginPath();
-      spectrumCtx.moveTo(0, y);
-      spectrumCtx.lineTo(w, y);
-      spectrumCtx.stroke();
+      const y = h - dbToNorm(db) * h;
+      ctx.beginPath();
+      ctx.moveTo(0, y);
+      ctx.lineTo(w, y);
+      ctx.stroke();
     }
+  }
 
-    if (state.fftBins.length > 8) {
-      const nyquist = 24000;
-      const maxBin = state.fftBins.length - 1;
+  // Bin index -> normalised x position, recomputed only when the bin count changes.
+  function buildBinLayout(binCount) {
+    const nyquist = 24000;
+    const maxBin = binCount - 1;
+    const indices = [];
+    const xs = [];
 
-      spectrumCtx.beginPath();
-      spectrumCtx.lineWidth = 2;
-      spectrumCtx.strokeStyle = "rgba(39, 193, 168, 0.95)";
+    for (let index = 1; index < maxBin; index += 1) {
+      const frequency = (index / maxBin) * nyquist;
 
-      let started = false;
+      if (frequency < MIN_FREQ || frequency > MAX_FREQ) {
+        continue;
+      }
 
-      for (let index = 1; index < maxBin; index += 1) {
-        const frequency = (index / maxBin) * nyquist;
+      indices.push(index);
+      xs.push(freqToNorm(frequency));
+    }
 
-        if (frequency < MIN_FREQ || frequency > MAX_FREQ) {
-          continue;
-        }
+    return { binCount, indices, xs: Float32Array.from(xs) };
+  }
+
+  function createCanvas2DSpectrumRenderer(canvas) {
+    const ctx = canvas.getContext("2d");
+    let layout = null;
+
+    function draw(bins) {
+      const { w, h, dpr } = sizeCanvasToDisplay(canvas);
+
+      ctx.setTransform(dpr, 0, 0, dpr, 0, 0);
+      ctx.clearRect(0, 0, w, h);
+
+      if (bins.length <= 8) {
+        return;
+      }
 
-        const x = freqToNorm(frequency) * w;
-        const db = clamp(Number(state.fftBins[index]), DB_MIN, DB_MAX);
-        const y = h - ((db - DB_MIN) / (DB_MAX - DB_MIN)) * h;
+      if (!layout || layout.binCount !== bins.length) {
+        layout = buildBinLayout(bins.length);
+      }
+
+      ctx.beginPath();
+      ctx.lineWidth = 2;
+      ctx.strokeStyle = "rgba(39, 193, 168, 0.95)";
+
+      for (let point = 0; point < layout.indices.length; point += 1) {
+        const x = layout.xs[point] * w;
+        const y = h - dbToNorm(Number(bins[layout.indices[point]])) * h;
 
-        if (!started) {
-          spectrumCtx.moveTo(x, y);
-          started = true;
+        if (point === 0) {
+          ctx.moveTo(x, y);
         } else {
-          spectrumCtx.lineTo(x, y);
+          ctx.lineTo(x, y);
         }
       }
 
-      spectrumCtx.stroke();
+      ctx.stroke();
     }
 
-    updateMidiIndicator();
-    window.requestAnimationFrame(drawSpectrum);
+    return { draw };
+  }
+
+  // WebGL path: x positions live in a static vertex buffer and only the dB values are
+  // uploaded per frame. The 2px line is a triangle strip offset by +-1px in the shader.
+  function createWebGLSpectrumRenderer(canvas) {
+    const gl = canvas.getContext("webgl", { premultipliedAlpha: false, antialias: true });
+
+    if (!gl) {
+      return null;
+    }
+
+    const vertexSource = `
+      attribute float a_x;
+      attribute float a_side;
+      attribute float a_db;
+      uniform vec2 u_dbRange;
+      uniform float u_halfThickness;
+      void main() {
+        float norm = (clamp(a_db, u_dbRange.x, u_dbRange.y) - u_dbRange.x) / (u_dbRange.y - u_dbRange.x);
+        float y = norm * 2.0 - 1.0 + a_side * u_halfThickness;
+        gl_Position = vec4(a_x * 2.0 - 1.0, y, 0.0, 1.0);
+      }
+    `;
+
+    const fragmentSource = `
+      precision mediump float;
+      uniform vec4 u_colour;
+      void main() {
+        gl_FragColor = u_colour;
+      }
+    `;
+
+    function compile(type, source) {
+      const shader = gl.createShader(type);
+      gl.shaderSource(shader, source);
+      gl.compileShader(shader);
+      return gl.getShaderParameter(shader, gl.COMPILE_STATUS) ? shader : null;
+    }
+
+    const vertexShader = compile(gl.VERTEX_SHADER, vertexSource);
+    const fragmentShader = compile(gl.FRAGMENT_SHADER, fragmentSource);
+
+    if (!vertexShader || !fragmentShader) {
+      return null;
+    }
+
+    const program = gl.createProgram();
+    gl.attachShader(program, vertexShader);
+    gl.attachShader(program, fragmentShader);
+    gl.linkProgram(program);
+
+    if (!gl.getProgramParameter(program, gl.LINK_STATUS)) {
+      return null;
+    }
+
+    const locations = {
+      x: gl.getAttribLocation(program, "a_x"),
+      side: gl.getAttribLocation(program, "a_side"),
+      db: gl.getAttribLocation(program, "a_db"),
+      dbRange: gl.getUniformLocation(program, "u_dbRange"),
+      halfThickness: gl.getUniformLocation(program, "u_halfThickness"),
+      colour: gl.getUniformLocation(program, "u_colour")
+    };
+
+    const staticBuffer = gl.createBuffer();
+    const dbBuffer = gl.createBuffer();
+
+    let layout = null;
+    let dbValues = new Float32Array(0);
+
+    function uploadLayout(bins) {
+      layout = buildBinLayout(bins.length);
+
+      const vertexCount = layout.indices.length * 2;
+      const staticData = new Float32Array(vertexCount * 2);
+
+      for (let point = 0; point < layout.indices.length; point += 1) {
+        staticData[point * 4] = layout.xs[point];
+        staticData[point * 4 + 1] = 1;
+        staticData[point * 4 + 2] = layout.xs[point];
+        staticData[point * 4 + 3] = -1;
+      }
+
+      gl.bindBuffer(gl.ARRAY_BUFFER, staticBuffer);
+      gl.bufferData(gl.ARRAY_BUFFER, staticData, gl.STATIC_DRAW);
+
+      dbValues = new Float32Array(vertexCount);
+      gl.bindBuffer(gl.ARRAY_BUFFER, dbBuffer);
+      gl.bufferData(gl.ARRAY_BUFFER, dbValues.byteLength, gl.DYNAMIC_DRAW);
+    }
+
+    function draw(bins) {
+      const { h, dpr } = sizeCanvasToDisplay(canvas);
+
+      gl.viewport(0, 0, canvas.width, canvas.height);
+      gl.clearColor(0, 0, 0, 0);
+      gl.clear(gl.COLOR_BUFFER_BIT);
+
+      if (bins.length <= 8) {
+        return;
+      }
+
+      if (!layout || layout.binCount !== bins.length) {
+        uploadLayout(bins);
+      }
+
+      for (let point = 0; point < layout.indices.length; point += 1) {
+        const db = Number(bins[layout.indices[point]]);
+        dbValues[point * 2] = db;
+        dbValues[point * 2 + 1] = db;
+      }
+
+      gl.useProgram(program);
+      gl.enable(gl.BLEND);
+      gl.blendFunc(gl.SRC_ALPHA, gl.ONE_MINUS_SRC_ALPHA);
+
+      gl.uniform2f(locations.dbRange, DB_MIN, DB_MAX);
+      gl.uniform1f(locations.halfThickness, 2 / Math.max(1, h * dpr) * dpr);
+      gl.uniform4f(locations.colour, 39 / 255, 193 / 255, 168 / 255, 0.95);
+
+      gl.bindBuffer(gl.ARRAY_BUFFER, staticBuffer);
+      gl.enableVertexAttribArray(locations.x);
+      gl.vertexAttribPointer(locations.x, 1, gl.FLOAT, false, 8, 0);
+      gl.enableVertexAttribArray(locations.side);
+      gl.vertexAttribPointer(locations.side, 1, gl.FLOAT, false, 8, 4);
+
+      gl.bindBuffer(gl.ARRAY_BUFFER, dbBuffer);
+      gl.bufferSubData(gl.ARRAY_BUFFER, 0, dbValues);
+      gl.enableVertexAttribArray(locations.db);
+      gl.vertexAttribPointer(locations.db, 1, gl.FLOAT, false, 0, 0);
+
+      gl.drawArrays(gl.TRIANGLE_STRIP, 0, dbValues.length);
+    }
+
+    return { draw };
+  }
+
+  const spectrumRenderer = createWebGLSpectrumRenderer(spectrumCanvas) || createCanvas2DSpectrumRenderer(spectrumCanvas);
+
+  function observeResizes() {
+    const invalidateAll = () => requestRender({ grid: true, spectrum: true, curves: true });
+
+    if (typeof ResizeObserver === "function") {
+      const observer = new ResizeObserver(invalidateAll);
+      observer.observe(spectrumCanvas);
+      document.querySelectorAll(".curve-canvas").forEach((canvas) => observer.observe(canvas));
+    } else {
+      window.addEventListener("resize", invalidateAll);
+    }
   }
 
   function connectBackend() {
@@ -756,16 +1132,29 @@
       applyMidiStatus(payload);
     });
 
+    backend.addEventListener("profiling", (payload) => {
+      applyProfilingSnapshot(payload);
+    });
+
     backend.emitEvent("requestState", {});
+
+    // Two frames: the first callback runs before paint, the second after it.
+    window.requestAnimationFrame(() => {
+      window.requestAnimationFrame(() => {
+        backend.emitEvent("uiReady", {});
+      });
+    });
   }
 
   function boot() {
     initDefaultParams();
     buildBandPanels();
     setupCrossoverDragging();
+    setupDiagnosticsPanel();
     refreshAllControls();
     connectBackend();
-    drawSpectrum();
+    observeResizes();
+    requestRender({ grid: true, spectrum: true, curves: true });
   }
 
   boot();
@@ -1,11 +1,24 @@
 #include "PluginProcessor.h"
 
-#include "PluginEditor.h"
+#include "diagnostics/RealtimeSafety.h"
+#include "diagnostics/TraceRecorder.h"
+
+#include <algorithm>
+
+#if ! MULTICHAINER_HEADLESS
+ #include "PluginEditor.h"
+#endif
 
 namespace
 {
 constexpr auto crossoverLowMidID = "crossover.f1";
 constexpr auto crossoverMidHighID = "crossover.f2";
+constexpr auto cpuGovernorID = "governor.enabled";
+
+// Binary state: magic, version, entry count, then (UTF-8 parameter ID, plain float value)
+// pairs. Later versions may append data after the entries; older readers ignore it.
+constexpr juce::uint32 binaryStateMagic = 0x5453434d; // "MCST" as little-endian bytes
+constexpr int binaryStateVersion = 1;
 
 juce::NormalisableRange<float> makeFrequencyRange (float minHz, float maxHz, float centre)
 {
@@ -14,39 +27,107 @@ juce::NormalisableRange<float> makeFrequencyRange (float minHz, float maxHz, flo
     return range;
 }
 
-float readRaw (std::atomic<float>* value, float fallback)
+template <typename Parameter>
+Parameter* findParameter (juce::AudioProcessorValueTreeState& state, const juce::String& parameterID)
+{
+    auto* parameter = dynamic_cast<Parameter*> (state.getParameter (parameterID));
+    jassert (parameter != nullptr);
+    return parameter;
+}
+
+float readValue (const juce::AudioParameterFloat* parameter, float fallback) noexcept
 {
-    return value != nullptr ? value->load (std::memory_order_relaxed) : fallback;
+    return parameter != nullptr ? parameter->get() : fallback;
 }
 } // namespace
 
 MultiChainerAudioProcessor::MultiChainerAudioProcessor()
     : AudioProcessor (BusesProperties().withInput ("Input", juce::AudioChannelSet::stereo(), true)
-                                          .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
+                                          .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                                          .withOutput ("Low", juce::AudioChannelSet::stereo(), false)
+                                          .withOutput ("Mid", juce::AudioChannelSet::stereo(), false)
+                                          .withOutput ("High", juce::AudioChannelSet::stereo(), false)),
       apvts (*this, nullptr, "Parameters", createParameterLayout()),
       crossover (multichainer::dsp::LinearPhaseCrossover::defaultTapCount)
 {
-    cacheRawParameterPointers();
+    multichainer::diagnostics::TraceRecorder::initialise();
+    cacheParameterPointers();
+
+    captureRecorder = multichainer::diagnostics::CaptureRecorder::createFromEnvironment (sizeof (BlockParameters));
 }
 
-MultiChainerAudioProcessor::~MultiChainerAudioProcessor() = default;
+MultiChainerAudioProcessor::~MultiChainerAudioProcessor()
+{
+#if MULTICHAINER_ENABLE_RT_CHECKS
+    multichainer::diagnostics::RealtimeSafety::logPendingViolations();
+#endif
+}
 
 void MultiChainerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    crossover.prepare (sampleRate, samplesPerBlock, juce::jmax (1, getTotalNumOutputChannels()));
+    // The band buses mirror the main bus, so only its channels run through the DSP.
+    mainBusChannels = juce::jmax (1, getMainBusNumOutputChannels());
+    int bandOutputMask = 0;
+
+    for (size_t band = 0; band < bandOutputChannels.size(); ++band)
+    {
+        const auto* bus = getBus (false, static_cast<int> (band) + 1);
+        const auto enabled = bus != nullptr && bus->isEnabled();
+
+        bandOutputChannels[band] = enabled ? bus->getChannelIndexInProcessBlockBuffer (0) : -1;
+        bandOutputMask |= enabled ? (1 << band) : 0;
+    }
+
+    // The DSP stages only ever see internal tiles, so they are sized for a tile rather than
+    // for whatever block size the host announces (or later exceeds). prepare() designs (and
+    // persists) the requested pair, so request the session's crossovers rather than leaving
+    // the built-in defaults for the worker to replace after the first block.
+    crossover.setTargetFrequencies (readValue (crossoverLowMid, 200.0f), readValue (crossoverMidHigh, 2500.0f));
+    crossover.prepare (sampleRate, processingTileSize, mainBusChannels);
     crossover.reset();
 
-    ducker.prepare (sampleRate, samplesPerBlock, juce::jmax (1, getTotalNumOutputChannels()));
+    ducker.prepare (sampleRate, processingTileSize, mainBusChannels);
     ducker.reset();
 
     fftAnalyzer.prepare (samplesPerBlock);
     fftAnalyzer.reset();
 
+    scratchArena.layout ([this] (multichainer::dsp::ScratchArena& arena)
+                         {
+                             crossover.carveScratch (arena);
+                             ducker.carveScratch (arena);
+                             fftAnalyzer.carveScratch (arena);
+                         });
+
+    stageProfiler.prepare (sampleRate);
+    cpuGovernor.prepare (sampleRate);
+
+    silenceHoldSamples = crossover.getTailSamples();
+    silentInputSamples = 0;
+
+    if (captureRecorder != nullptr)
+        captureRecorder->recordPrepare (sampleRate,
+                                        samplesPerBlock,
+                                        juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()),
+                                        bandOutputMask);
+
     setLatencySamples (crossover.getLatencySamples());
 }
 
 void MultiChainerAudioProcessor::releaseResources()
 {
+#if MULTICHAINER_ENABLE_RT_CHECKS
+    multichainer::diagnostics::RealtimeSafety::logPendingViolations();
+#endif
+}
+
+void MultiChainerAudioProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime (isNonRealtime);
+
+    // Offline renders must be reproducible, so crossover changes are designed in-line
+    // instead of landing whenever the background designer gets to them.
+    crossover.setSynchronousDesign (isNonRealtime);
 }
 
 bool MultiChainerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -57,77 +138,291 @@ bool MultiChainerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
         return false;
 
+    // Low/Mid/High band outputs are optional and always stereo.
+    for (int bus = 1; bus < layouts.outputBuses.size(); ++bus)
+    {
+        const auto& channelSet = layouts.outputBuses.getReference (bus);
+
+        if (! channelSet.isDisabled() && channelSet != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return true;
 }
 
 void MultiChainerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    MULTICHAINER_REALTIME_SECTION();
+    MULTICHAINER_TRACE_THREAD_NAME ("Audio");
+    MULTICHAINER_TRACE_SCOPE_VALUE ("processBlock", buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
 
+    using Stage = multichainer::diagnostics::StageProfiler::Stage;
+    using Level = multichainer::core::CpuGovernor::Level;
+
+    // Offline renders and capture replays must not depend on timing, so they never degrade.
+    cpuGovernor.setEnabled (cpuGovernorEnabled != nullptr && cpuGovernorEnabled->get() && ! isNonRealtime() && capturedBlock == nullptr);
+    const auto governorStartNs = cpuGovernor.isEnabled() ? multichainer::diagnostics::StageProfiler::now() : 0;
+
+    auto blockTimer = cpuGovernor.isShedding (Level::meteringSkipped) ? multichainer::diagnostics::StageProfiler::BlockTimer {}
+                                                                      : stageProfiler.startBlock();
+
     const auto totalInputChannels = getTotalNumInputChannels();
     const auto totalOutputChannels = getTotalNumOutputChannels();
     const auto numSamples = buffer.getNumSamples();
 
+    // Enabled band output buses are fully overwritten tile by tile below.
     for (auto channel = totalInputChannels; channel < totalOutputChannels; ++channel)
-        buffer.clear (channel, 0, numSamples);
+        if (! isBandOutputChannel (channel))
+            buffer.clear (channel, 0, numSamples);
 
-    const auto lowMidHz = readRaw (crossoverLowMid, 200.0f);
-    const auto midHighHz = readRaw (crossoverMidHigh, 2500.0f);
-    crossover.setTargetFrequencies (lowMidHz, midHighHz);
-
-    for (size_t band = 0; band < bandParameters.size(); ++band)
+    if (capturedBlock != nullptr)
     {
-        const auto& rawBand = bandParameters[band];
-
-        multichainer::dsp::MultibandDucker::BandParameters parameters;
-        parameters.midiChannel = juce::roundToInt (readRaw (rawBand.midiChannel, 0.0f));
+        blockParameters = capturedBlock->parameters;
+        crossover.applyDesignImmediately (capturedBlock->appliedLowMidHz, capturedBlock->appliedMidHighHz);
+    }
+    else
+    {
+        // Keep the previous block's values while the UI is midway through a batch.
+        BlockParameters latestParameters;
 
-        parameters.depthDb = readRaw (rawBand.depthDb, 0.0f);
-        parameters.delayMs = readRaw (rawBand.delayMs, 0.0f);
-        parameters.attackMs = readRaw (rawBand.attackMs, 20.0f);
-        parameters.holdMs = readRaw (rawBand.holdMs, 30.0f);
-        parameters.releaseMs = readRaw (rawBand.releaseMs, 180.0f);
-        parameters.curveShape = readRaw (rawBand.curveShape, 1.0f);
-        parameters.smoothing = readRaw (rawBand.smoothing, 0.2f);
+        if (readBlockParameters (latestParameters))
+            blockParameters = latestParameters;
 
-        ducker.setBandParameters (band, parameters);
+        crossover.setTargetFrequencies (blockParameters.lowMidHz, blockParameters.midHighHz);
+        crossover.applyPendingDesign();
     }
 
+    crossover.setEconomyDesignsEnabled (cpuGovernor.isEnabled());
+    crossover.setEconomyMode (cpuGovernor.isShedding (Level::economyCrossover));
+    fftAnalyzer.setFrameInterval (cpuGovernor.isShedding (Level::analyzerReduced) ? 4 : 1);
+
+    for (size_t band = 0; band < blockParameters.bands.size(); ++band)
+        ducker.setBandParameters (band, blockParameters.bands[band]);
+
+    // Captures do not record the economy designs, so blocks that use them are left out.
+    const auto recordBlock = captureRecorder != nullptr && ! crossover.isEconomyMode();
+
+    if (recordBlock)
+        captureRecorder->beginBlock (buffer, midiMessages, &blockParameters,
+                                     crossover.getAppliedLowMidHz(), crossover.getAppliedMidHighHz());
+    else if (captureRecorder != nullptr)
+        captureRecorder->skipBlock();
+
+    blockTimer.lap (Stage::parameters);
+
     ducker.clearBlockTriggers();
 
     uint16_t blockChannelMask = 0;
+    auto nextMidiEvent = midiMessages.cbegin();
+    const auto midiEnd = midiMessages.cend();
 
-    for (const auto metadata : midiMessages)
+    // Walk the host block in fixed tiles so each stage's working set stays cache-resident
+    // and host blocks larger than announced in prepareToPlay are handled safely.
+    for (int tileStart = 0; tileStart < numSamples; tileStart += processingTileSize)
     {
-        const auto& message = metadata.getMessage();
+        const auto tileSamples = juce::jmin (processingTileSize, numSamples - tileStart);
+        const auto tileEnd = tileStart + tileSamples;
+        const auto isLastTile = tileEnd == numSamples;
+
+        // Events past the block end (misbehaving hosts) are clamped into the last tile.
+        for (; nextMidiEvent != midiEnd; ++nextMidiEvent)
+        {
+            const auto metadata = *nextMidiEvent;
+
+            if (metadata.samplePosition >= tileEnd && ! isLastTile)
+                break;
+
+            const auto& message = metadata.getMessage();
+
+            if (message.getChannel() >= 1 && message.getChannel() <= 16)
+                blockChannelMask |= static_cast<uint16_t> (1u << static_cast<unsigned> (message.getChannel() - 1));
+
+            ducker.pushMidiMessage (message, metadata.samplePosition - tileStart, tileSamples);
+        }
+
+        blockTimer.lap (Stage::midi);
 
-        if (message.getChannel() >= 1 && message.getChannel() <= 16)
-            blockChannelMask |= static_cast<uint16_t> (1u << static_cast<unsigned> (message.getChannel() - 1));
+        tileView.setDataToReferTo (buffer.getArrayOfWritePointers(),
+                                   juce::jmin (mainBusChannels, buffer.getNumChannels()),
+                                   tileStart,
+                                   tileSamples);
 
-        ducker.pushMidiMessage (message, metadata.samplePosition, numSamples);
+        std::array<juce::AudioBuffer<float>*, multichainer::dsp::LinearPhaseCrossover::numBands> bandTargets {};
+
+        for (size_t band = 0; band < bandTargets.size(); ++band)
+        {
+            const auto firstChannel = bandOutputChannels[band];
+
+            if (firstChannel < 0 || firstChannel + mainBusChannels > buffer.getNumChannels())
+                continue;
+
+            bandOutputTileViews[band].setDataToReferTo (buffer.getArrayOfWritePointers() + firstChannel,
+                                                        mainBusChannels,
+                                                        tileStart,
+                                                        tileSamples);
+            bandTargets[band] = &bandOutputTileViews[band];
+        }
+
+        if (updateSilenceState (tileView, tileSamples))
+        {
+            tileView.clear();
+
+            for (auto* target : bandTargets)
+                if (target != nullptr)
+                    target->clear();
+
+            blockTimer.lap (Stage::mix);
+            continue;
+        }
+
+        processTile (tileView, { bandTargets[0], bandTargets[1], bandTargets[2] }, tileSamples, blockTimer);
     }
 
-    if (blockChannelMask != 0)
+    if (blockChannelMask != 0 && ! cpuGovernor.isShedding (Level::meteringSkipped))
     {
         observedMidiChannelsMask.fetch_or (blockChannelMask, std::memory_order_relaxed);
         midiActivityCounter.fetch_add (1, std::memory_order_relaxed);
     }
 
-    crossover.process (buffer, numSamples);
+    if (recordBlock)
+        captureRecorder->endBlock (buffer);
+
+    midiMessages.clear();
+    blockTimer.finish (numSamples);
+
+    if (cpuGovernor.isEnabled())
+        cpuGovernor.blockFinished (multichainer::diagnostics::StageProfiler::now() - governorStartNs, numSamples);
+}
+
+void MultiChainerAudioProcessor::processBlockBypassed (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    MULTICHAINER_REALTIME_SECTION();
+    MULTICHAINER_TRACE_THREAD_NAME ("Audio");
+    MULTICHAINER_TRACE_SCOPE_VALUE ("processBlockBypassed", buffer.getNumSamples());
+    juce::ScopedNoDenormals noDenormals;
+
+    using Stage = multichainer::diagnostics::StageProfiler::Stage;
+    auto blockTimer = stageProfiler.startBlock();
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto channelsInTile = juce::jmin (mainBusChannels, buffer.getNumChannels());
+
+    // Band buses are silent while bypassed; the main bus carries the latency-aligned input.
+    for (auto channel = channelsInTile; channel < buffer.getNumChannels(); ++channel)
+        buffer.clear (channel, 0, numSamples);
+
+    // Crossover changes still land, so un-bypassing resumes with the current design.
+    BlockParameters latestParameters;
+
+    if (readBlockParameters (latestParameters))
+        blockParameters = latestParameters;
+
+    crossover.setTargetFrequencies (blockParameters.lowMidHz, blockParameters.midHighHz);
+    crossover.applyPendingDesign();
+
+    // Triggers are dropped and the envelopes hold where they were.
+    ducker.clearBlockTriggers();
+    blockTimer.lap (Stage::parameters);
+
+    for (int tileStart = 0; tileStart < numSamples; tileStart += processingTileSize)
+    {
+        const auto tileSamples = juce::jmin (processingTileSize, numSamples - tileStart);
+
+        tileView.setDataToReferTo (buffer.getArrayOfWritePointers(), channelsInTile, tileStart, tileSamples);
+
+        // Shares the silence bookkeeping with processBlock, which relies on the histories and
+        // delay line holding only zeros once it reports the tail as flushed.
+        if (updateSilenceState (tileView, tileSamples))
+            tileView.clear();
+        else
+            crossover.processBypassed (tileView, tileView, tileSamples);
+    }
+
+    blockTimer.lap (Stage::crossover);
+
+    if (captureRecorder != nullptr)
+        captureRecorder->skipBlock();
+
+    midiMessages.clear();
+    blockTimer.finish (numSamples);
+}
+
+bool MultiChainerAudioProcessor::processCapturedBlock (juce::AudioBuffer<float>& buffer,
+                                                       juce::MidiBuffer& midiMessages,
+                                                       const juce::MemoryBlock& parameters,
+                                                       float appliedLowMidHz,
+                                                       float appliedMidHighHz)
+{
+    if (parameters.getSize() != sizeof (BlockParameters))
+        return false;
+
+    CapturedBlockState state;
+    std::memcpy (&state.parameters, parameters.getData(), sizeof (BlockParameters));
+    state.appliedLowMidHz = appliedLowMidHz;
+    state.appliedMidHighHz = appliedMidHighHz;
+
+    capturedBlock = &state;
+    processBlock (buffer, midiMessages);
+    capturedBlock = nullptr;
+
+    return true;
+}
+
+bool MultiChainerAudioProcessor::isBandOutputChannel (int channel) const noexcept
+{
+    return std::any_of (bandOutputChannels.begin(), bandOutputChannels.end(), [this, channel] (int firstChannel)
+    {
+        return firstChannel >= 0 && channel >= firstChannel && channel < firstChannel + mainBusChannels;
+    });
+}
+
+bool MultiChainerAudioProcessor::updateSilenceState (const juce::AudioBuffer<float>& tile, int numSamples) noexcept
+{
+    if (ducker.hasPendingTriggers() || ! ducker.areAllEnvelopesIdle() || tile.getMagnitude (0, numSamples) != 0.0f)
+    {
+        silentInputSamples = 0;
+        return false;
+    }
+
+    // Every stage holds only zeros once the tail has flushed (idle envelopes settle to exactly
+    // zero rather than stalling at a tiny residue), so skipping them is exact and the first
+    // non-silent tile resumes exactly where the stages left off.
+    //
+    // While an editor is subscribed, two more analyzer frames let the spectrum settle on
+    // silence before the stages stop running. Dormant instances skip that wait.
+    const auto holdSamples = silenceHoldSamples + (fftAnalyzer.isActive() ? 2 * multichainer::dsp::FFTAnalyzer::fftSize : 0);
+    const auto tailFlushed = silentInputSamples >= holdSamples;
+    silentInputSamples = juce::jmin (silentInputSamples + numSamples, holdSamples);
+    return tailFlushed;
+}
+
+void MultiChainerAudioProcessor::processTile (juce::AudioBuffer<float>& tile,
+                                              const multichainer::dsp::LinearPhaseCrossover::BandTargets& bandTargets,
+                                              int numSamples,
+                                              multichainer::diagnostics::StageProfiler::BlockTimer& blockTimer) noexcept
+{
+    using Stage = multichainer::diagnostics::StageProfiler::Stage;
+
+    // Bands with an enabled output bus are written straight into it, and the ducker's gain
+    // is applied there in place, so the bus carries exactly what the main mix sums.
+    crossover.process (tile, numSamples, bandTargets);
+    blockTimer.lap (Stage::crossover);
 
     auto& lowBand = crossover.getLowBandBuffer();
     auto& midBand = crossover.getMidBandBuffer();
     auto& highBand = crossover.getHighBandBuffer();
 
     ducker.processBands (lowBand, midBand, highBand, numSamples);
+    blockTimer.lap (Stage::ducker);
 
-    const auto channelsToMix = juce::jmin (buffer.getNumChannels(),
+    const auto channelsToMix = juce::jmin (tile.getNumChannels(),
                                            juce::jmin (lowBand.getNumChannels(),
                                                        juce::jmin (midBand.getNumChannels(), highBand.getNumChannels())));
 
     for (int channel = 0; channel < channelsToMix; ++channel)
     {
-        auto* output = buffer.getWritePointer (channel);
+        auto* output = tile.getWritePointer (channel);
 
         const auto* low = lowBand.getReadPointer (channel);
         const auto* mid = midBand.getReadPointer (channel);
@@ -137,27 +432,40 @@ void MultiChainerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             output[sample] = low[sample] + mid[sample] + high[sample];
     }
 
-    for (int channel = channelsToMix; channel < buffer.getNumChannels(); ++channel)
-        buffer.clear (channel, 0, numSamples);
+    for (int channel = channelsToMix; channel < tile.getNumChannels(); ++channel)
+        tile.clear (channel, 0, numSamples);
 
-    fftAnalyzer.pushBlock (buffer, juce::jmin (2, buffer.getNumChannels()));
+    blockTimer.lap (Stage::mix);
 
-    midiMessages.clear();
+    if (cpuGovernor.isShedding (multichainer::core::CpuGovernor::Level::analyzerPaused))
+        fftAnalyzer.skipBlock();
+    else
+        fftAnalyzer.pushBlock (tile, juce::jmin (2, tile.getNumChannels()));
+
+    blockTimer.lap (Stage::analyzer);
 }
 
 juce::AudioProcessorEditor* MultiChainerAudioProcessor::createEditor()
 {
+#if MULTICHAINER_HEADLESS
+    return nullptr;
+#else
     return new MultiChainerAudioProcessorEditor (*this);
+#endif
 }
 
 bool MultiChainerAudioProcessor::hasEditor() const
 {
-    return true;
+    return ! MULTICHAINER_HEADLESS;
 }
 
 const juce::String MultiChainerAudioProcessor::getName() const
 {
+#if MULTICHAINER_HEADLESS
+    return "MultiChainer";
+#else
     return JucePlugin_Name;
+#endif
 }
 
 bool MultiChainerAudioProcessor::acceptsMidi() const
@@ -205,21 +513,84 @@ void MultiChainerAudioProcessor::changeProgramName (int /*index*/, const juce::S
 
 void MultiChainerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    const auto state = apvts.copyState();
+    const auto parameterIDs = getParameterIDs();
+
+    juce::MemoryOutputStream stream (destData, false);
+    stream.writeInt (static_cast<int> (binaryStateMagic));
+    stream.writeShort (static_cast<short> (binaryStateVersion));
+    stream.writeShort (static_cast<short> (parameterIDs.size()));
 
-    if (auto xml = state.createXml())
-        copyXmlToBinary (*xml, destData);
+    for (const auto& parameterID : parameterIDs)
+    {
+        const auto* parameter = apvts.getParameter (parameterID);
+
+        stream.writeString (parameterID);
+        stream.writeFloat (parameter != nullptr ? parameter->convertFrom0to1 (parameter->getValue()) : 0.0f);
+    }
 }
 
 void MultiChainerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    if (auto xmlState = getXmlFromBinary (data, sizeInBytes))
+    std::vector<std::pair<juce::String, float>> values;
+
+    if (sizeInBytes >= 8 && static_cast<juce::uint32> (juce::ByteOrder::littleEndianInt (data)) == binaryStateMagic)
+    {
+        juce::MemoryInputStream stream (data, static_cast<size_t> (sizeInBytes), false);
+        stream.skipNextBytes (4);
+
+        if (stream.readShort() < 1)
+            return;
+
+        const auto numEntries = static_cast<int> (static_cast<juce::uint16> (stream.readShort()));
+        values.reserve (static_cast<size_t> (numEntries));
+
+        for (int entry = 0; entry < numEntries && ! stream.isExhausted(); ++entry)
+        {
+            auto parameterID = stream.readString();
+            values.emplace_back (std::move (parameterID), stream.readFloat());
+        }
+    }
+    else if (auto xmlState = getXmlFromBinary (data, sizeInBytes))
+    {
+        // Legacy APVTS XML: <Parameters><PARAM id="..." value="..."/>...</Parameters>
+        if (! xmlState->hasTagName (apvts.state.getType()))
+            return;
+
+        for (const auto* parameterXml : xmlState->getChildWithTagNameIterator ("PARAM"))
+            values.emplace_back (parameterXml->getStringAttribute ("id"),
+                                 static_cast<float> (parameterXml->getDoubleAttribute ("value")));
+    }
+    else
+    {
+        return;
+    }
+
+    applyParameterValues (values);
+}
+
+void MultiChainerAudioProcessor::applyParameterValues (const std::vector<std::pair<juce::String, float>>& values)
+{
+    // One batch, so the audio thread sees the whole preset at once and redesigns the crossover
+    // once; unchanged parameters are skipped so their listeners stay quiet. Parameters the state
+    // does not mention (e.g. added after it was saved) go back to their defaults.
+    beginParameterBatchFromUI();
+
+    for (const auto& parameterID : getParameterIDs())
     {
-        const auto newState = juce::ValueTree::fromXml (*xmlState);
+        auto* parameter = dynamic_cast<juce::RangedAudioParameter*> (apvts.getParameter (parameterID));
+
+        if (parameter == nullptr)
+            continue;
+
+        const auto stored = std::find_if (values.rbegin(), values.rend(), [&parameterID] (const auto& entry) { return entry.first == parameterID; });
+        const auto normalised = stored != values.rend() ? parameter->convertTo0to1 (stored->second)
+                                                        : parameter->getDefaultValue();
 
-        if (newState.isValid())
-            apvts.replaceState (newState);
+        if (! juce::exactlyEqual (normalised, parameter->getValue()))
+            writeParameterInBatch (*parameter, normalised, false);
     }
+
+    endParameterBatchFromUI();
 }
 
 juce::StringArray MultiChainerAudioProcessor::getParameterIDs() const
@@ -228,6 +599,7 @@ juce::StringArray MultiChainerAudioProcessor::getParameterIDs() const
 
     ids.add (crossoverLowMidID);
     ids.add (crossoverMidHighID);
+    ids.add (cpuGovernorID);
 
     for (int band = 0; band < static_cast<int> (bandParameters.size()); ++band)
     {
@@ -239,6 +611,7 @@ juce::StringArray MultiChainerAudioProcessor::getParameterIDs() const
         ids.add (getBandParameterID (band, "releaseMs"));
         ids.add (getBandParameterID (band, "curveShape"));
         ids.add (getBandParameterID (band, "smoothing"));
+        ids.add (getBandParameterID (band, "voiceMode"));
     }
 
     return ids;
@@ -291,17 +664,107 @@ juce::var MultiChainerAudioProcessor::buildMidiInputSnapshot() const
     return juce::var (root.release());
 }
 
-void MultiChainerAudioProcessor::setParameterFromUI (const juce::String& parameterID, float value)
+juce::var MultiChainerAudioProcessor::buildProfilingSnapshot() const
+{
+    auto snapshot = multichainer::diagnostics::StageProfiler::toVar (stageProfiler.getSnapshot());
+
+    if (auto* object = snapshot.getDynamicObject())
+    {
+        auto memory = std::make_unique<juce::DynamicObject>();
+        memory->setProperty ("instanceBytes", static_cast<juce::int64> (sizeof (*this)));
+        memory->setProperty ("scratchBytes", static_cast<juce::int64> (scratchArena.getUsedBytes()));
+
+        // Heap owned by this instance outside the arena; shared designs are reported apart, as
+        // identical instances hold the same ones.
+        const auto heapBytes = crossover.getHeapBytes()
+                             + fftAnalyzer.getHeapBytes()
+                             + (captureRecorder != nullptr ? captureRecorder->getHeapBytes() : 0);
+        memory->setProperty ("heapBytes", static_cast<juce::int64> (heapBytes));
+        memory->setProperty ("sharedDesignBytes", static_cast<juce::int64> (crossover.getHeldDesignBytes()));
+        object->setProperty ("memory", juce::var (memory.release()));
+        object->setProperty ("governor", multichainer::core::CpuGovernor::toVar (cpuGovernor.getSnapshot()));
+    }
+
+    return snapshot;
+}
+
+void MultiChainerAudioProcessor::beginParameterBatchFromUI() noexcept
+{
+    // Counting writers rather than locking lets a host restore state on its own thread while the
+    // editor flushes edits, and nested batches simply add one more writer.
+    [[maybe_unused]] const auto previous = uiParameterBatchState.fetch_add (1, std::memory_order_acq_rel);
+    jassert ((previous & uiParameterBatchWriterMask) != uiParameterBatchWriterMask);
+}
+
+void MultiChainerAudioProcessor::endParameterBatchFromUI()
+{
+    // Drops one writer and bumps the generation in a single step, so a reader that saw no
+    // writers can tell whether a batch opened and closed while it was reading.
+    const auto previous = uiParameterBatchState.fetch_add (uiParameterBatchGeneration - 1, std::memory_order_acq_rel);
+    jassert ((previous & uiParameterBatchWriterMask) != 0);
+
+    // The last batch out sends everything queued so far, after the audio thread can see it.
+    if ((previous & uiParameterBatchWriterMask) == 1)
+        sendPendingParameterNotifications();
+}
+
+void MultiChainerAudioProcessor::writeParameterInBatch (juce::RangedAudioParameter& parameter, float normalised, bool wrapInGesture)
+{
+    jassert ((uiParameterBatchState.load (std::memory_order_relaxed) & uiParameterBatchWriterMask) != 0);
+
+    parameter.setValue (normalised);
+
+    const juce::ScopedLock lock (pendingNotificationLock);
+    pendingNotifications.push_back ({ &parameter, normalised, wrapInGesture });
+}
+
+void MultiChainerAudioProcessor::sendPendingParameterNotifications()
+{
+    std::vector<PendingParameterNotification> notifications;
+
+    {
+        const juce::ScopedLock lock (pendingNotificationLock);
+        notifications.swap (pendingNotifications);
+    }
+
+    // No lock is held here: the host may call back into the processor, or start a batch of its own.
+    for (const auto& notification : notifications)
+    {
+        if (notification.wrapInGesture)
+            notification.parameter->beginChangeGesture();
+
+        notification.parameter->sendValueChangedMessageToListeners (notification.normalised);
+
+        if (notification.wrapInGesture)
+            notification.parameter->endChangeGesture();
+    }
+}
+
+void MultiChainerAudioProcessor::beginParameterGestureFromUI (const juce::String& parameterID)
 {
     if (auto* parameter = apvts.getParameter (parameterID))
+        parameter->beginChangeGesture();
+}
+
+void MultiChainerAudioProcessor::endParameterGestureFromUI (const juce::String& parameterID)
+{
+    if (auto* parameter = apvts.getParameter (parameterID))
+        parameter->endChangeGesture();
+}
+
+void MultiChainerAudioProcessor::setParameterFromUI (const juce::String& parameterID, float value, bool gestureInProgress)
+{
+    if (auto* parameter = dynamic_cast<juce::RangedAudioParameter*> (apvts.getParameter (parameterID)))
     {
-        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
-        {
-            const auto normalised = ranged->convertTo0to1 (value);
-            parameter->beginChangeGesture();
-            parameter->setValueNotifyingHost (normalised);
-            parameter->endChangeGesture();
-        }
+        const auto normalised = parameter->convertTo0to1 (value);
+
+        if (juce::exactlyEqual (normalised, parameter->getValue()))
+            return;
+
+        // Inside an open batch this only queues the notification; on its own it is sent right away.
+        beginParameterBatchFromUI();
+        writeParameterInBatch (*parameter, normalised, ! gestureInProgress);
+        endParameterBatchFromUI();
     }
 }
 
@@ -321,6 +784,11 @@ juce::AudioProcessorValueTreeState::ParameterLayout MultiChainerAudioProcessor::
         makeFrequencyRange (20.0f, 20000.0f, 3000.0f),
         2500.0f));
 
+    layout.add (std::make_unique<juce::AudioParameterBool> (
+        juce::ParameterID { cpuGovernorID, 1 },
+        "CPU Governor",
+        false));
+
     for (int band = 0; band < static_cast<int> (multichainer::dsp::MultibandDucker::numBands); ++band)
     {
         const auto bandName = juce::String ("Band ") + juce::String (band + 1) + " ";
@@ -373,30 +841,71 @@ juce::AudioProcessorValueTreeState::ParameterLayout MultiChainerAudioProcessor::
             bandName + "Curve Smoothing",
             juce::NormalisableRange<float> (0.0f, 1.0f),
             0.2f));
+
+        layout.add (std::make_unique<juce::AudioParameterChoice> (
+            juce::ParameterID { getBandParameterID (band, "voiceMode"), 1 },
+            bandName + "Voice Mode",
+            juce::StringArray { "Mono", "Poly Max", "Poly Sum" },
+            0));
     }
 
     return layout;
 }
 
-void MultiChainerAudioProcessor::cacheRawParameterPointers()
+void MultiChainerAudioProcessor::cacheParameterPointers()
 {
-    crossoverLowMid = apvts.getRawParameterValue (crossoverLowMidID);
-    crossoverMidHigh = apvts.getRawParameterValue (crossoverMidHighID);
+    crossoverLowMid = findParameter<juce::AudioParameterFloat> (apvts, crossoverLowMidID);
+    crossoverMidHigh = findParameter<juce::AudioParameterFloat> (apvts, crossoverMidHighID);
+    cpuGovernorEnabled = findParameter<juce::AudioParameterBool> (apvts, cpuGovernorID);
 
     for (int band = 0; band < static_cast<int> (bandParameters.size()); ++band)
     {
-        auto& rawBand = bandParameters[static_cast<size_t> (band)];
+        auto& bandPointers = bandParameters[static_cast<size_t> (band)];
+
+        bandPointers.midiChannel = findParameter<juce::AudioParameterInt> (apvts, getBandParameterID (band, "midiChannel"));
+
+        bandPointers.depthDb = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "depthDb"));
+        bandPointers.delayMs = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "delayMs"));
+        bandPointers.attackMs = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "attackMs"));
+        bandPointers.holdMs = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "holdMs"));
+        bandPointers.releaseMs = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "releaseMs"));
+        bandPointers.curveShape = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "curveShape"));
+        bandPointers.smoothing = findParameter<juce::AudioParameterFloat> (apvts, getBandParameterID (band, "smoothing"));
+        bandPointers.voiceMode = findParameter<juce::AudioParameterChoice> (apvts, getBandParameterID (band, "voiceMode"));
+    }
+}
 
-        rawBand.midiChannel = apvts.getRawParameterValue (getBandParameterID (band, "midiChannel"));
+bool MultiChainerAudioProcessor::readBlockParameters (BlockParameters& destination) const
+{
+    // Seqlock-style read: any open UI batch means values are being written.
+    const auto stateBefore = uiParameterBatchState.load (std::memory_order_acquire);
 
-        rawBand.depthDb = apvts.getRawParameterValue (getBandParameterID (band, "depthDb"));
-        rawBand.delayMs = apvts.getRawParameterValue (getBandParameterID (band, "delayMs"));
-        rawBand.attackMs = apvts.getRawParameterValue (getBandParameterID (band, "attackMs"));
-        rawBand.holdMs = apvts.getRawParameterValue (getBandParameterID (band, "holdMs"));
-        rawBand.releaseMs = apvts.getRawParameterValue (getBandParameterID (band, "releaseMs"));
-        rawBand.curveShape = apvts.getRawParameterValue (getBandParameterID (band, "curveShape"));
-        rawBand.smoothing = apvts.getRawParameterValue (getBandParameterID (band, "smoothing"));
+    if ((stateBefore & uiParameterBatchWriterMask) != 0)
+        return false;
+
+    destination.lowMidHz = readValue (crossoverLowMid, 200.0f);
+    destination.midHighHz = readValue (crossoverMidHigh, 2500.0f);
+
+    for (size_t band = 0; band < bandParameters.size(); ++band)
+    {
+        const auto& bandPointers = bandParameters[band];
+        auto& parameters = destination.bands[band];
+
+        parameters.midiChannel = bandPointers.midiChannel != nullptr ? bandPointers.midiChannel->get() : 0;
+
+        parameters.depthDb = readValue (bandPointers.depthDb, 0.0f);
+        parameters.delayMs = readValue (bandPointers.delayMs, 0.0f);
+        parameters.attackMs = readValue (bandPointers.attackMs, 20.0f);
+        parameters.holdMs = readValue (bandPointers.holdMs, 30.0f);
+        parameters.releaseMs = readValue (bandPointers.releaseMs, 180.0f);
+        parameters.curveShape = readValue (bandPointers.curveShape, 1.0f);
+        parameters.smoothing = readValue (bandPointers.smoothing, 0.2f);
+        parameters.voiceMode = static_cast<multichainer::dsp::EnvelopeBank::VoiceMode> (
+            juce::jlimit (0, 2, bandPointers.voiceMode != nullptr ? bandPointers.voiceMode->getIndex() : 0));
     }
+
+    std::atomic_thread_fence (std::memory_order_acquire);
+    return uiParameterBatchState.load (std::memory_order_relaxed) == stateBefore;
 }
 
 juce::String MultiChainerAudioProcessor::getBandParameterID (int band, juce::StringRef name)
@@ -2,9 +2,17 @@
 
 #include <JuceHeader.h>
 
+#ifndef MULTICHAINER_HEADLESS
+ #define MULTICHAINER_HEADLESS 0 // 1 = build without the editor / web view (console tools)
+#endif
+
+#include "core/CpuGovernor.h"
+#include "diagnostics/CaptureRecorder.h"
+#include "diagnostics/StageProfiler.h"
 #include "dsp/FFTAnalyzer.h"
 #include "dsp/LinearPhaseCrossover.h"
 #include "dsp/MultibandDucker.h"
+#include "dsp/ScratchArena.h"
 
 class MultiChainerAudioProcessor final : public juce::AudioProcessor
 {
@@ -14,11 +22,16 @@ public:
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime (bool isNonRealtime) noexcept override;
 
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    // Runs only the crossover's latency delay (see LinearPhaseCrossover::processBypassed), so
+    // the reported latency holds while bypassed and un-bypassing is seamless.
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
 
@@ -43,41 +56,133 @@ public:
 
     multichainer::dsp::FFTAnalyzer& getFFTAnalyzer() noexcept { return fftAnalyzer; }
 
+    // Stage timing is only collected while a consumer is registered (see StageProfiler).
+    multichainer::diagnostics::StageProfiler& getStageProfiler() noexcept { return stageProfiler; }
+
+    // Replays one block written by CaptureRecorder (see MultiChainerReplay). The captured
+    // parameter snapshot and crossover pair replace the live parameter read and background
+    // designer, so the output matches the captured session bit for bit. Offline use only.
+    bool processCapturedBlock (juce::AudioBuffer<float>& buffer,
+                               juce::MidiBuffer& midiMessages,
+                               const juce::MemoryBlock& parameters,
+                               float appliedLowMidHz,
+                               float appliedMidHighHz);
+
     juce::StringArray getParameterIDs() const;
     juce::var buildParameterSnapshot() const;
     juce::var buildMidiInputSnapshot() const;
-    void setParameterFromUI (const juce::String& parameterID, float value);
+    juce::var buildProfilingSnapshot() const;
+
+    // UI edits arrive on the message thread. A batch makes every value set between begin/end
+    // visible to the audio thread at once, so paired edits (e.g. f1 + f2) cause one FIR design.
+    // Batches may overlap across threads (e.g. a host restoring state); the audio thread waits
+    // for all of them. Host and listener notifications are sent once the last batch closes.
+    void beginParameterBatchFromUI() noexcept;
+    void endParameterBatchFromUI();
+
+    void beginParameterGestureFromUI (const juce::String& parameterID);
+    void endParameterGestureFromUI (const juce::String& parameterID);
+    void setParameterFromUI (const juce::String& parameterID, float value, bool gestureInProgress = false);
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 private:
-    struct BandRawParameters
+    // Host blocks are processed in tiles of this many samples (the last one may be shorter).
+    static constexpr int processingTileSize = 64;
+
+    // The audio thread reads the parameters' own values: batches write them with setValue()
+    // and notify later, and the APVTS raw values only follow that notification.
+    struct BandParameterPointers
+    {
+        juce::AudioParameterInt* midiChannel = nullptr;
+
+        juce::AudioParameterFloat* depthDb = nullptr;
+        juce::AudioParameterFloat* delayMs = nullptr;
+        juce::AudioParameterFloat* attackMs = nullptr;
+        juce::AudioParameterFloat* holdMs = nullptr;
+        juce::AudioParameterFloat* releaseMs = nullptr;
+        juce::AudioParameterFloat* curveShape = nullptr;
+        juce::AudioParameterFloat* smoothing = nullptr;
+        juce::AudioParameterChoice* voiceMode = nullptr;
+    };
+
+    struct PendingParameterNotification
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        float normalised = 0.0f;
+        bool wrapInGesture = false;
+    };
+
+    struct BlockParameters
+    {
+        float lowMidHz = 200.0f;
+        float midHighHz = 2500.0f;
+
+        std::array<multichainer::dsp::MultibandDucker::BandParameters, multichainer::dsp::MultibandDucker::numBands> bands;
+    };
+
+    // Captures store BlockParameters as raw bytes.
+    static_assert (std::is_trivially_copyable_v<BlockParameters>);
+
+    struct CapturedBlockState
     {
-        std::atomic<float>* midiChannel = nullptr;
-
-        std::atomic<float>* depthDb = nullptr;
-        std::atomic<float>* delayMs = nullptr;
-        std::atomic<float>* attackMs = nullptr;
-        std::atomic<float>* holdMs = nullptr;
-        std::atomic<float>* releaseMs = nullptr;
-        std::atomic<float>* curveShape = nullptr;
-        std::atomic<float>* smoothing = nullptr;
+        BlockParameters parameters;
+        float appliedLowMidHz = 0.0f;
+        float appliedMidHighHz = 0.0f;
     };
 
-    void cacheRawParameterPointers();
+    void cacheParameterPointers();
+    void applyParameterValues (const std::vector<std::pair<juce::String, float>>& values);
+    // Writes the value inside the open batch and queues its notification.
+    void writeParameterInBatch (juce::RangedAudioParameter& parameter, float normalised, bool wrapInGesture);
+    void sendPendingParameterNotifications();
+    bool readBlockParameters (BlockParameters& destination) const;
+    bool isBandOutputChannel (int channel) const noexcept;
+    // Counts consecutive silent, untriggered input; returns true once the stages can be skipped.
+    bool updateSilenceState (const juce::AudioBuffer<float>& tile, int numSamples) noexcept;
+    void processTile (juce::AudioBuffer<float>& tile,
+                      const multichainer::dsp::LinearPhaseCrossover::BandTargets& bandTargets,
+                      int numSamples,
+                      multichainer::diagnostics::StageProfiler::BlockTimer& blockTimer) noexcept;
 
     static juce::String getBandParameterID (int band, juce::StringRef name);
 
     juce::AudioProcessorValueTreeState apvts;
 
-    std::atomic<float>* crossoverLowMid = nullptr;
-    std::atomic<float>* crossoverMidHigh = nullptr;
+    juce::AudioParameterFloat* crossoverLowMid = nullptr;
+    juce::AudioParameterFloat* crossoverMidHigh = nullptr;
+    juce::AudioParameterBool* cpuGovernorEnabled = nullptr;
 
-    std::array<BandRawParameters, multichainer::dsp::MultibandDucker::numBands> bandParameters;
+    std::array<BandParameterPointers, multichainer::dsp::MultibandDucker::numBands> bandParameters;
 
     multichainer::dsp::LinearPhaseCrossover crossover;
     multichainer::dsp::MultibandDucker ducker;
     multichainer::dsp::FFTAnalyzer fftAnalyzer;
+    multichainer::dsp::ScratchArena scratchArena;
+    juce::AudioBuffer<float> tileView; // refers into the host buffer, never owns samples
+    int mainBusChannels = 0;
+
+    // Optional Low/Mid/High output buses: the first host-buffer channel of each enabled bus
+    // (-1 when disabled) and tile views the crossover writes those bands into directly.
+    std::array<int, multichainer::dsp::LinearPhaseCrossover::numBands> bandOutputChannels { -1, -1, -1 };
+    std::array<juce::AudioBuffer<float>, multichainer::dsp::LinearPhaseCrossover::numBands> bandOutputTileViews;
+    int silenceHoldSamples = 0;
+    int silentInputSamples = 0;
+
+    std::unique_ptr<multichainer::diagnostics::CaptureRecorder> captureRecorder;
+    const CapturedBlockState* capturedBlock = nullptr; // set only inside processCapturedBlock()
+    multichainer::diagnostics::StageProfiler stageProfiler;
+    multichainer::core::CpuGovernor cpuGovernor;
+
+    BlockParameters blockParameters;
+    // Low 16 bits: open batches. High bits: generation, bumped as each batch closes.
+    static constexpr uint32_t uiParameterBatchWriterMask = 0xffffu;
+    static constexpr uint32_t uiParameterBatchGeneration = 0x10000u;
+    std::atomic<uint32_t> uiParameterBatchState { 0 };
+
+    // Held only to queue or take notifications, never while sending them or by the audio thread.
+    juce::CriticalSection pendingNotificationLock;
+    std::vector<PendingParameterNotification> pendingNotifications;
 
     std::atomic<uint32_t> midiActivityCounter { 0 };
     std::atomic<uint16_t> observedMidiChannelsMask { 0 };
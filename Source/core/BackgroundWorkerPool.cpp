@@ -0,0 +1,197 @@
+#include "BackgroundWorkerPool.h"
+
+#include "diagnostics/TraceRecorder.h"
+
+namespace multichainer::core
+{
+BackgroundWorkerPool& BackgroundWorkerPool::getInstance()
+{
+    static BackgroundWorkerPool instance;
+    return instance;
+}
+
+BackgroundWorkerPool::BackgroundWorkerPool()
+{
+    // Designs take milliseconds and are rare; two workers keep one busy designer from
+    // delaying another instance without adding threads per core.
+    const auto numWorkers = juce::jlimit (1, 2, juce::SystemStats::getNumCpus() - 1);
+
+    for (int index = 0; index < numWorkers; ++index)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, index));
+        workers.back()->startThread (juce::Thread::Priority::low);
+    }
+}
+
+BackgroundWorkerPool::~BackgroundWorkerPool()
+{
+    stopping.store (true, std::memory_order_release);
+
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    wakeSequence.fetch_add (1, std::memory_order_acq_rel);
+    wakeSequence.notify_all();
+
+    for (auto& worker : workers)
+        worker->stopThread (2000);
+}
+
+bool BackgroundWorkerPool::schedule (Task& task) noexcept
+{
+    if (task.queued.exchange (true, std::memory_order_acq_rel))
+        return false;
+
+    auto* head = inbox.load (std::memory_order_relaxed);
+
+    do
+    {
+        task.next = head;
+    }
+    while (! inbox.compare_exchange_weak (head, &task, std::memory_order_release, std::memory_order_relaxed));
+
+    wakeSequence.fetch_add (1, std::memory_order_acq_rel);
+    wakeSequence.notify_one();
+    return true;
+}
+
+void BackgroundWorkerPool::cancel (Task& task)
+{
+    std::unique_lock<std::mutex> lock (workerMutex);
+
+    moveInboxToReadyLists();
+
+    if (removeReadyTask (task))
+        task.queued.store (false, std::memory_order_release);
+
+    taskFinished.wait (lock, [&task] { return ! task.running; });
+}
+
+void BackgroundWorkerPool::runWorker (Worker& worker)
+{
+    while (! worker.threadShouldExit())
+    {
+        // Read the sequence before looking for work: a schedule() that lands after the
+        // check bumps it, so wait() returns immediately instead of missing the wakeup.
+        const auto observedSequence = wakeSequence.load (std::memory_order_acquire);
+
+        Task* task = nullptr;
+
+        {
+            const std::lock_guard<std::mutex> lock (workerMutex);
+            moveInboxToReadyLists();
+            task = popReadyTask();
+
+            if (task != nullptr)
+            {
+                task->running = true;
+
+                // Cleared before running so requests made during run() queue another pass.
+                task->queued.store (false, std::memory_order_release);
+            }
+        }
+
+        if (task == nullptr)
+        {
+            if (stopping.load (std::memory_order_acquire))
+                return;
+
+            wakeSequence.wait (observedSequence, std::memory_order_acquire);
+            continue;
+        }
+
+        task->run();
+
+        {
+            const std::lock_guard<std::mutex> lock (workerMutex);
+            task->running = false;
+        }
+
+        taskFinished.notify_all();
+    }
+}
+
+void BackgroundWorkerPool::moveInboxToReadyLists()
+{
+    // The inbox is LIFO; reverse it so tasks of equal priority run in request order.
+    Task* reversed = nullptr;
+
+    for (auto* task = inbox.exchange (nullptr, std::memory_order_acquire); task != nullptr;)
+    {
+        auto* next = task->next;
+        task->next = reversed;
+        reversed = task;
+        task = next;
+    }
+
+    while (reversed != nullptr)
+    {
+        auto* task = reversed;
+        reversed = task->next;
+        task->next = nullptr;
+
+        auto& list = readyLists[static_cast<size_t> (task->priority)];
+
+        if (list.tail != nullptr)
+            list.tail->next = task;
+        else
+            list.head = task;
+
+        list.tail = task;
+    }
+}
+
+BackgroundWorkerPool::Task* BackgroundWorkerPool::popReadyTask()
+{
+    for (auto& list : readyLists)
+    {
+        if (auto* task = list.head)
+        {
+            list.head = task->next;
+
+            if (list.head == nullptr)
+                list.tail = nullptr;
+
+            task->next = nullptr;
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+bool BackgroundWorkerPool::removeReadyTask (Task& task)
+{
+    auto& list = readyLists[static_cast<size_t> (task.priority)];
+    Task* previous = nullptr;
+
+    for (auto* current = list.head; current != nullptr; previous = current, current = current->next)
+    {
+        if (current != &task)
+            continue;
+
+        (previous != nullptr ? previous->next : list.head) = current->next;
+
+        if (list.tail == current)
+            list.tail = previous;
+
+        current->next = nullptr;
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+BackgroundWorkerPool::Worker::Worker (BackgroundWorkerPool& ownerIn, int index)
+    : juce::Thread ("MultiChainer Worker " + juce::String (index + 1)),
+      owner (ownerIn)
+{
+}
+
+void BackgroundWorkerPool::Worker::run()
+{
+    MULTICHAINER_TRACE_THREAD_NAME ("Background Worker");
+    owner.runWorker (*this);
+}
+} // namespace multichainer::core
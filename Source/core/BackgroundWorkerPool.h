@@ -0,0 +1,99 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace multichainer::core
+{
+// One small pool of background threads shared by every plugin instance in the process.
+// Work is described by intrusive Task objects owned by the client, so schedule() neither
+// allocates nor locks and is safe to call from the audio thread. A task that is already
+// queued is not queued again (requests coalesce), and idle workers block until work
+// arrives instead of waking on a timeout.
+class BackgroundWorkerPool
+{
+public:
+    enum class Priority
+    {
+        high,   // audible results pending, e.g. crossover redesigns
+        normal,
+        low     // housekeeping, e.g. cache warm-up
+    };
+
+    class Task
+    {
+    public:
+        explicit Task (Priority priorityToUse = Priority::normal) noexcept : priority (priorityToUse) {}
+        virtual ~Task() = default;
+
+        virtual void run() = 0;
+
+        Priority getPriority() const noexcept { return priority; }
+
+    private:
+        friend class BackgroundWorkerPool;
+
+        const Priority priority;
+        std::atomic<bool> queued { false };
+        Task* next = nullptr;
+        bool running = false; // guarded by the pool's worker mutex
+
+        JUCE_DECLARE_NON_COPYABLE (Task)
+    };
+
+    static BackgroundWorkerPool& getInstance();
+
+    // Lock-free; returns false if the task was already waiting to run.
+    bool schedule (Task& task) noexcept;
+
+    // Removes the task if queued and waits for it to finish if running. Owners must call this
+    // (off the audio thread, once nothing can schedule the task again) before destroying it.
+    void cancel (Task& task);
+
+    int getNumWorkers() const noexcept { return static_cast<int> (workers.size()); }
+
+    ~BackgroundWorkerPool();
+
+private:
+    static constexpr int numPriorities = 3;
+
+    class Worker final : public juce::Thread
+    {
+    public:
+        Worker (BackgroundWorkerPool& ownerIn, int index);
+        void run() override;
+
+    private:
+        BackgroundWorkerPool& owner;
+    };
+
+    struct TaskList
+    {
+        Task* head = nullptr;
+        Task* tail = nullptr;
+    };
+
+    BackgroundWorkerPool();
+
+    void runWorker (Worker& worker);
+    void moveInboxToReadyLists();
+    Task* popReadyTask();
+    bool removeReadyTask (Task& task);
+
+    // Multi-producer inbox (Treiber stack); workers take it whole, so no ABA.
+    std::atomic<Task*> inbox { nullptr };
+    std::atomic<uint32_t> wakeSequence { 0 };
+    std::atomic<bool> stopping { false };
+
+    std::mutex workerMutex;
+    std::condition_variable taskFinished;
+    std::array<TaskList, numPriorities> readyLists;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    JUCE_DECLARE_NON_COPYABLE (BackgroundWorkerPool)
+};
+} // namespace multichainer::core
@@ -0,0 +1,124 @@
+#include "CpuGovernor.h"
+
+#include "diagnostics/TraceRecorder.h"
+
+namespace multichainer::core
+{
+void CpuGovernor::prepare (double sampleRateToUse) noexcept
+{
+    sampleRate = juce::jmax (1.0, sampleRateToUse);
+    smoothedLoad = 0.0;
+    samplesSinceTransition = 0;
+    samplesBelowRestoreLoad = 0;
+    moveTo (Level::full);
+}
+
+void CpuGovernor::setEnabled (bool shouldBeEnabled) noexcept
+{
+    if (enabled == shouldBeEnabled)
+        return;
+
+    enabled = shouldBeEnabled;
+    publishedEnabled.store (enabled, std::memory_order_relaxed);
+
+    smoothedLoad = 0.0;
+    samplesBelowRestoreLoad = 0;
+    moveTo (Level::full);
+}
+
+void CpuGovernor::blockFinished (uint64_t durationNs, int numSamples) noexcept
+{
+    if (! enabled || numSamples <= 0)
+        return;
+
+    const auto budgetNs = static_cast<double> (numSamples) * 1.0e9 / sampleRate;
+    const auto load = static_cast<double> (durationNs) / budgetNs;
+
+    // Counters saturate well before overflowing; both thresholds are a few seconds at most.
+    constexpr int counterLimit = 1 << 30;
+
+    smoothedLoad += (load - smoothedLoad) * loadSmoothing;
+    samplesSinceTransition = juce::jmin (samplesSinceTransition + numSamples, counterLimit);
+    samplesBelowRestoreLoad = load < restoreLoad ? juce::jmin (samplesBelowRestoreLoad + numSamples, counterLimit) : 0;
+
+    publishedLoad.store (static_cast<float> (smoothedLoad), std::memory_order_relaxed);
+    blocksAtLevel[static_cast<size_t> (level)].fetch_add (1, std::memory_order_relaxed);
+
+    const auto overBudget = load >= spikeLoad || smoothedLoad >= escalateLoad;
+
+    if (overBudget && level != Level::economyCrossover
+        && samplesSinceTransition >= static_cast<int> (escalateHoldSeconds * sampleRate))
+    {
+        escalations.fetch_add (1, std::memory_order_relaxed);
+        moveTo (static_cast<Level> (static_cast<int> (level) + 1));
+        return;
+    }
+
+    if (level != Level::full && samplesBelowRestoreLoad >= static_cast<int> (restoreHoldSeconds * sampleRate))
+    {
+        restorations.fetch_add (1, std::memory_order_relaxed);
+        moveTo (static_cast<Level> (static_cast<int> (level) - 1));
+    }
+}
+
+void CpuGovernor::moveTo (Level newLevel) noexcept
+{
+    if (newLevel != level)
+    {
+        MULTICHAINER_TRACE_INSTANT ("governorLevel", static_cast<int> (newLevel));
+    }
+
+    level = newLevel;
+    samplesSinceTransition = 0;
+    samplesBelowRestoreLoad = 0;
+    publishedLevel.store (static_cast<int> (level), std::memory_order_relaxed);
+}
+
+CpuGovernor::Snapshot CpuGovernor::getSnapshot() const noexcept
+{
+    Snapshot snapshot;
+    snapshot.enabled = publishedEnabled.load (std::memory_order_relaxed);
+    snapshot.level = static_cast<Level> (publishedLevel.load (std::memory_order_relaxed));
+    snapshot.escalations = escalations.load (std::memory_order_relaxed);
+    snapshot.restorations = restorations.load (std::memory_order_relaxed);
+    snapshot.smoothedLoad = publishedLoad.load (std::memory_order_relaxed);
+
+    for (size_t index = 0; index < blocksAtLevel.size(); ++index)
+        snapshot.blocksAtLevel[index] = blocksAtLevel[index].load (std::memory_order_relaxed);
+
+    return snapshot;
+}
+
+juce::var CpuGovernor::toVar (const Snapshot& snapshot)
+{
+    auto levels = std::make_unique<juce::DynamicObject>();
+
+    for (int index = 0; index < numLevels; ++index)
+        levels->setProperty (getLevelName (static_cast<Level> (index)),
+                             static_cast<juce::int64> (snapshot.blocksAtLevel[static_cast<size_t> (index)]));
+
+    auto object = std::make_unique<juce::DynamicObject>();
+    object->setProperty ("enabled", snapshot.enabled);
+    object->setProperty ("level", getLevelName (snapshot.level));
+    object->setProperty ("escalations", static_cast<juce::int64> (snapshot.escalations));
+    object->setProperty ("restorations", static_cast<juce::int64> (snapshot.restorations));
+    object->setProperty ("smoothedLoad", snapshot.smoothedLoad);
+    object->setProperty ("blocksAtLevel", juce::var (levels.release()));
+
+    return juce::var (object.release());
+}
+
+const char* CpuGovernor::getLevelName (Level level) noexcept
+{
+    switch (level)
+    {
+        case Level::full:             return "full";
+        case Level::analyzerReduced:  return "analyzerReduced";
+        case Level::analyzerPaused:   return "analyzerPaused";
+        case Level::meteringSkipped:  return "meteringSkipped";
+        case Level::economyCrossover: return "economyCrossover";
+    }
+
+    return "";
+}
+} // namespace multichainer::core
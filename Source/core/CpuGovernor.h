@@ -0,0 +1,90 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+
+namespace multichainer::core
+{
+// Opt-in real-time budget governor. The audio thread reports how long each block took; when
+// that eats too much of the block's real-time budget the governor sheds optional work one
+// level at a time, and gives it back one level at a time once load has stayed low. Levels
+// are cumulative and shed the least noticeable work first. Only the last changes the audio
+// (shallower band slopes, audible while bands are ducked or on the band buses), and the
+// crossover crossfades into and out of it.
+//
+// The audio thread reads and updates the level without locks. Transitions are counted and
+// traced for the diagnostics panel.
+class CpuGovernor
+{
+public:
+    enum class Level
+    {
+        full,
+        analyzerReduced,   // spectrum analyzer computes every fourth frame
+        analyzerPaused,    // analyzer receives no audio
+        meteringSkipped,   // stage profiling and MIDI activity metering stop
+        economyCrossover   // crossover runs its precomputed economy FIR designs
+    };
+
+    static constexpr int numLevels = static_cast<int> (Level::economyCrossover) + 1;
+
+    struct Snapshot
+    {
+        bool enabled = false;
+        Level level = Level::full;
+        uint64_t escalations = 0;
+        uint64_t restorations = 0;
+        double smoothedLoad = 0.0; // block time / block duration
+        std::array<uint64_t, numLevels> blocksAtLevel {};
+    };
+
+    void prepare (double sampleRateToUse) noexcept;
+
+    // Audio thread, once per block before processing. Disabling returns to full quality.
+    void setEnabled (bool shouldBeEnabled) noexcept;
+    bool isEnabled() const noexcept { return enabled; }
+
+    // Audio thread.
+    Level getLevel() const noexcept { return level; }
+    bool isShedding (Level candidate) const noexcept { return level >= candidate; }
+
+    // Audio thread, once per block after processing; no-op while disabled.
+    void blockFinished (uint64_t durationNs, int numSamples) noexcept;
+
+    // Any thread.
+    Snapshot getSnapshot() const noexcept;
+
+    static juce::var toVar (const Snapshot& snapshot);
+    static const char* getLevelName (Level level) noexcept;
+
+private:
+    // A block over budget escalates at once; otherwise the smoothed load must cross
+    // escalateLoad. Restoring needs restoreHoldSeconds below restoreLoad, so the gap between
+    // the two thresholds and the hold keep the level from oscillating.
+    static constexpr double spikeLoad = 1.0;
+    static constexpr double escalateLoad = 0.7;
+    static constexpr double restoreLoad = 0.4;
+    static constexpr double loadSmoothing = 0.2;         // per block
+    static constexpr double escalateHoldSeconds = 0.05;  // lets a step take effect before the next
+    static constexpr double restoreHoldSeconds = 2.0;
+
+    void moveTo (Level newLevel) noexcept;
+
+    // Audio thread.
+    bool enabled = false;
+    Level level = Level::full;
+    double sampleRate = 44100.0;
+    double smoothedLoad = 0.0;
+    int samplesSinceTransition = 0;
+    int samplesBelowRestoreLoad = 0;
+
+    // Published for getSnapshot().
+    std::atomic<bool> publishedEnabled { false };
+    std::atomic<int> publishedLevel { 0 };
+    std::atomic<float> publishedLoad { 0.0f };
+    std::atomic<uint64_t> escalations { 0 };
+    std::atomic<uint64_t> restorations { 0 };
+    std::array<std::atomic<uint64_t>, numLevels> blocksAtLevel {};
+};
+} // namespace multichainer::core
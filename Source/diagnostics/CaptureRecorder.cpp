@@ -0,0 +1,418 @@
+#include "CaptureRecorder.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace multichainer::diagnostics
+{
+namespace
+{
+constexpr int recordHeaderBytes = 2 * static_cast<int> (sizeof (uint32_t));
+constexpr int maxRecordPayloadBytes = 256 << 20;
+} // namespace
+
+std::unique_ptr<CaptureRecorder> CaptureRecorder::createFromEnvironment (size_t parameterBytesToUse)
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable ("MULTICHAINER_CAPTURE", {});
+
+    if (path.isEmpty())
+        return nullptr;
+
+    auto recorder = std::make_unique<CaptureRecorder> (juce::File::getCurrentWorkingDirectory().getChildFile (path),
+                                                       parameterBytesToUse);
+
+    if (! recorder->isOpen())
+        return nullptr;
+
+    return recorder;
+}
+
+CaptureRecorder::CaptureRecorder (const juce::File& requestedFile, size_t parameterBytesToUse)
+    : parameterBytes (parameterBytesToUse),
+      flushTask (*this)
+{
+    // Creating the file right away makes the next instance pick the next free name.
+    const auto file = requestedFile.getNonexistentSibling();
+    stream = file.createOutputStream();
+
+    if (stream == nullptr)
+        return;
+
+    FileHeader header;
+    header.parameterBytes = static_cast<uint32_t> (parameterBytes);
+    stream->write (&header, sizeof (header));
+    stream->flush();
+
+    ring.allocate (static_cast<size_t> (ringBytes), true);
+
+    // Start the shared workers here so schedule() never constructs the pool on the audio thread.
+    core::BackgroundWorkerPool::getInstance();
+}
+
+CaptureRecorder::~CaptureRecorder()
+{
+    core::BackgroundWorkerPool::getInstance().cancel (flushTask);
+
+    drain();
+
+    if (stream != nullptr && unreportedDrops > 0)
+    {
+        const uint32_t gapHeader[] { gapRecord, static_cast<uint32_t> (sizeof (uint64_t)) };
+        stream->write (gapHeader, sizeof (gapHeader));
+        stream->write (&unreportedDrops, sizeof (unreportedDrops));
+        stream->flush();
+    }
+}
+
+void CaptureRecorder::recordPrepare (double sampleRate, int maxBlockSize, int numChannels, int bandOutputMask)
+{
+    const juce::ScopedLock lock (drainLock);
+
+    if (stream == nullptr)
+        return;
+
+    // Earlier blocks must reach the file before the configuration change.
+    drain();
+
+    const uint32_t recordHeader[] { prepareRecord, 24 };
+    const int32_t sizes[] { static_cast<int32_t> (maxBlockSize),
+                            static_cast<int32_t> (numChannels),
+                            static_cast<int32_t> (bandOutputMask),
+                            0 };
+
+    stream->write (recordHeader, sizeof (recordHeader));
+    stream->write (&sampleRate, sizeof (sampleRate));
+    stream->write (sizes, sizeof (sizes));
+    stream->flush();
+}
+
+void CaptureRecorder::beginBlock (const juce::AudioBuffer<float>& input,
+                                  const juce::MidiBuffer& midi,
+                                  const void* parameters,
+                                  float appliedLowMidHz,
+                                  float appliedMidHighHz) noexcept
+{
+    openBlockHashOffset = -1;
+
+    if (stream == nullptr)
+        return;
+
+    BlockHeader header;
+    header.numSamples = input.getNumSamples();
+    header.numChannels = input.getNumChannels();
+    header.appliedLowMidHz = appliedLowMidHz;
+    header.appliedMidHighHz = appliedMidHighHz;
+
+    for (const auto metadata : midi)
+    {
+        ++header.numMidiEvents;
+        header.midiBytes += 2 * static_cast<int32_t> (sizeof (int32_t)) + padTo4 (metadata.numBytes);
+    }
+
+    const auto parameterBlobBytes = padTo4 (static_cast<int> (parameterBytes));
+    const auto audioBytes = header.numChannels * header.numSamples * static_cast<int> (sizeof (float));
+    const auto payloadBytes = static_cast<int> (sizeof (BlockHeader)) + parameterBlobBytes + header.midiBytes + audioBytes;
+
+    if (unreportedDrops > 0)
+    {
+        constexpr auto gapBytes = recordHeaderBytes + static_cast<int> (sizeof (uint64_t));
+        Reservation gap;
+
+        if (! reserve (gapBytes + recordHeaderBytes + payloadBytes, gap))
+        {
+            ++unreportedDrops;
+            droppedBlocks.fetch_add (1, std::memory_order_relaxed);
+            return;
+        }
+
+        const uint32_t gapHeader[] { gapRecord, static_cast<uint32_t> (sizeof (uint64_t)) };
+        writeAt (gap, 0, gapHeader, recordHeaderBytes);
+        writeAt (gap, recordHeaderBytes, &unreportedDrops, static_cast<int> (sizeof (unreportedDrops)));
+        publish (gapBytes);
+        unreportedDrops = 0;
+    }
+
+    if (! reserve (recordHeaderBytes + payloadBytes, openBlock))
+    {
+        ++unreportedDrops;
+        droppedBlocks.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint32_t recordHeader[] { blockRecord, static_cast<uint32_t> (payloadBytes) };
+    auto offset = 0;
+
+    const auto put = [this, &offset] (const void* data, int bytes)
+    {
+        writeAt (openBlock, offset, data, bytes);
+        offset += bytes;
+    };
+
+    const auto putPadding = [&put] (int bytes)
+    {
+        static constexpr char zeros[4] {};
+        put (zeros, padTo4 (bytes) - bytes);
+    };
+
+    put (recordHeader, recordHeaderBytes);
+    openBlockHashOffset = offset + static_cast<int> (offsetof (BlockHeader, outputHash));
+    put (&header, static_cast<int> (sizeof (header)));
+
+    put (parameters, static_cast<int> (parameterBytes));
+    putPadding (static_cast<int> (parameterBytes));
+
+    for (const auto metadata : midi)
+    {
+        const int32_t eventHeader[] { static_cast<int32_t> (metadata.samplePosition), static_cast<int32_t> (metadata.numBytes) };
+        put (eventHeader, static_cast<int> (sizeof (eventHeader)));
+        put (metadata.data, metadata.numBytes);
+        putPadding (metadata.numBytes);
+    }
+
+    for (int channel = 0; channel < header.numChannels; ++channel)
+        put (input.getReadPointer (channel), header.numSamples * static_cast<int> (sizeof (float)));
+
+    jassert (offset == openBlock.totalBytes);
+}
+
+void CaptureRecorder::endBlock (const juce::AudioBuffer<float>& output) noexcept
+{
+    if (openBlockHashOffset < 0)
+        return;
+
+    const auto hash = hashAudio (output, output.getNumChannels(), output.getNumSamples());
+    writeAt (openBlock, openBlockHashOffset, &hash, static_cast<int> (sizeof (hash)));
+
+    publish (openBlock.totalBytes);
+    openBlockHashOffset = -1;
+}
+
+void CaptureRecorder::publish (int bytes) noexcept
+{
+    fifo.finishedWrite (bytes);
+
+    if (fifo.getNumReady() >= flushThresholdBytes)
+        core::BackgroundWorkerPool::getInstance().schedule (flushTask);
+}
+
+uint64_t CaptureRecorder::hashAudio (const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) noexcept
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (int channel = 0; channel < juce::jmin (numChannels, buffer.getNumChannels()); ++channel)
+    {
+        const auto* samples = buffer.getReadPointer (channel);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            uint32_t word;
+            std::memcpy (&word, samples + sample, sizeof (word));
+
+            hash ^= word;
+            hash *= 0x100000001b3ull;
+        }
+    }
+
+    return hash;
+}
+
+bool CaptureRecorder::reserve (int bytes, Reservation& reservation) noexcept
+{
+    if (fifo.getFreeSpace() < bytes)
+        return false;
+
+    fifo.prepareToWrite (bytes, reservation.start1, reservation.size1, reservation.start2, reservation.size2);
+    reservation.totalBytes = bytes;
+    return reservation.size1 + reservation.size2 == bytes;
+}
+
+void CaptureRecorder::writeAt (const Reservation& reservation, int offset, const void* data, int bytes) noexcept
+{
+    const auto* source = static_cast<const char*> (data);
+
+    while (bytes > 0)
+    {
+        const auto inFirst = offset < reservation.size1;
+        const auto ringIndex = inFirst ? reservation.start1 + offset : reservation.start2 + (offset - reservation.size1);
+        const auto available = inFirst ? reservation.size1 - offset : reservation.size2 - (offset - reservation.size1);
+        const auto chunk = juce::jmin (bytes, available);
+
+        std::memcpy (ring.get() + ringIndex, source, static_cast<size_t> (chunk));
+
+        source += chunk;
+        offset += chunk;
+        bytes -= chunk;
+    }
+}
+
+void CaptureRecorder::drain()
+{
+    const juce::ScopedLock lock (drainLock);
+
+    if (stream == nullptr)
+        return;
+
+    const auto ready = fifo.getNumReady();
+
+    if (ready <= 0)
+        return;
+
+    int start1 = 0;
+    int size1 = 0;
+    int start2 = 0;
+    int size2 = 0;
+
+    fifo.prepareToRead (ready, start1, size1, start2, size2);
+
+    stream->write (ring.get() + start1, static_cast<size_t> (size1));
+
+    if (size2 > 0)
+        stream->write (ring.get() + start2, static_cast<size_t> (size2));
+
+    fifo.finishedRead (size1 + size2);
+    stream->flush();
+}
+
+//==============================================================================
+CaptureRecorder::FlushTask::FlushTask (CaptureRecorder& ownerIn)
+    : core::BackgroundWorkerPool::Task (core::BackgroundWorkerPool::Priority::low),
+      owner (ownerIn)
+{
+}
+
+void CaptureRecorder::FlushTask::run()
+{
+    owner.drain();
+}
+
+//==============================================================================
+CaptureReader::CaptureReader (std::unique_ptr<juce::InputStream> source)
+    : input (std::move (source))
+{
+    if (input == nullptr)
+        return;
+
+    valid = input->read (&header, sizeof (header)) == static_cast<int> (sizeof (header))
+            && header.magic == CaptureRecorder::fileMagic
+            && header.version == CaptureRecorder::formatVersion;
+}
+
+CaptureReader::Next CaptureReader::readNext()
+{
+    if (! valid)
+        return Next::corrupt;
+
+    for (;;)
+    {
+        uint32_t recordHeader[2] {};
+        const auto headerBytes = input->read (recordHeader, sizeof (recordHeader));
+
+        if (headerBytes == 0)
+            return Next::end;
+
+        // A truncated tail is what a crashed session leaves behind; treat it as the end.
+        if (headerBytes != static_cast<int> (sizeof (recordHeader)))
+            return Next::end;
+
+        const auto type = recordHeader[0];
+        const auto payloadBytes = static_cast<int> (recordHeader[1]);
+
+        if (payloadBytes < 0 || payloadBytes > maxRecordPayloadBytes)
+            return Next::corrupt;
+
+        switch (type)
+        {
+            case CaptureRecorder::prepareRecord:
+            {
+                int32_t sizes[4] {};
+
+                if (payloadBytes != 24
+                    || input->read (&prepare.sampleRate, sizeof (prepare.sampleRate)) != static_cast<int> (sizeof (double))
+                    || input->read (sizes, sizeof (sizes)) != static_cast<int> (sizeof (sizes)))
+                {
+                    return Next::end;
+                }
+
+                prepare.maxBlockSize = sizes[0];
+                prepare.numChannels = sizes[1];
+                prepare.bandOutputMask = sizes[2];
+                return Next::prepare;
+            }
+
+            case CaptureRecorder::blockRecord:
+                return readBlockPayload (payloadBytes) ? Next::block : Next::end;
+
+            case CaptureRecorder::gapRecord:
+                if (payloadBytes != static_cast<int> (sizeof (uint64_t))
+                    || input->read (&gapDroppedBlocks, sizeof (gapDroppedBlocks)) != static_cast<int> (sizeof (uint64_t)))
+                {
+                    return Next::end;
+                }
+
+                return Next::gap;
+
+            default:
+                // Unknown record from a newer writer: skip it.
+                input->skipNextBytes (payloadBytes);
+                break;
+        }
+    }
+}
+
+bool CaptureReader::readBlockPayload (int payloadBytes)
+{
+    scratch.setSize (static_cast<size_t> (payloadBytes), false);
+
+    if (input->read (scratch.getData(), payloadBytes) != payloadBytes)
+        return false;
+
+    const auto* bytes = static_cast<const char*> (scratch.getData());
+    auto& header = block.header;
+
+    if (payloadBytes < static_cast<int> (sizeof (CaptureRecorder::BlockHeader)))
+        return false;
+
+    std::memcpy (&header, bytes, sizeof (header));
+
+    const auto parameterBlobBytes = CaptureRecorder::padTo4 (static_cast<int> (getParameterBytes()));
+    const auto audioBytes = static_cast<juce::int64> (header.numChannels) * header.numSamples * static_cast<juce::int64> (sizeof (float));
+
+    if (header.numChannels < 0 || header.numSamples < 0 || header.midiBytes < 0
+        || static_cast<juce::int64> (sizeof (header)) + parameterBlobBytes + header.midiBytes + audioBytes != payloadBytes)
+    {
+        return false;
+    }
+
+    auto offset = static_cast<int> (sizeof (header));
+
+    block.parameters.replaceAll (bytes + offset, getParameterBytes());
+    offset += parameterBlobBytes;
+
+    block.midi.clear();
+    const auto midiEnd = offset + header.midiBytes;
+
+    for (int event = 0; event < header.numMidiEvents && offset + 8 <= midiEnd; ++event)
+    {
+        int32_t eventHeader[2] {};
+        std::memcpy (eventHeader, bytes + offset, sizeof (eventHeader));
+        offset += static_cast<int> (sizeof (eventHeader));
+
+        if (eventHeader[1] < 0 || offset + eventHeader[1] > midiEnd)
+            return false;
+
+        block.midi.addEvent (bytes + offset, eventHeader[1], eventHeader[0]);
+        offset += CaptureRecorder::padTo4 (eventHeader[1]);
+    }
+
+    offset = midiEnd;
+    block.audio.setSize (header.numChannels, header.numSamples, false, false, true);
+
+    for (int channel = 0; channel < header.numChannels; ++channel)
+    {
+        std::memcpy (block.audio.getWritePointer (channel), bytes + offset, static_cast<size_t> (header.numSamples) * sizeof (float));
+        offset += header.numSamples * static_cast<int> (sizeof (float));
+    }
+
+    return true;
+}
+} // namespace multichainer::diagnostics
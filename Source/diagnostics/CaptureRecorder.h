@@ -0,0 +1,186 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "core/BackgroundWorkerPool.h"
+
+namespace multichainer::diagnostics
+{
+// Opt-in capture of everything that feeds processBlock, for reproducing field issues with
+// MultiChainerReplay. A processor constructed while the MULTICHAINER_CAPTURE environment
+// variable names a file records, per host block, the input audio, MIDI events with their
+// sample offsets, the parameter snapshot the block used, the crossover pair it ran with and
+// a hash of its output. The audio thread copies records into a preallocated byte ring
+// (wait-free; blocks that do not fit are dropped and marked with a gap record). Once the ring
+// holds flushThresholdBytes it schedules a task on the shared BackgroundWorkerPool that
+// appends them to the file; the rest is written at prepare and on destruction.
+//
+// File layout, native byte order: FileHeader, then records of { uint32 type, uint32
+// payloadBytes, payload }, each payload padded to 4 bytes.
+class CaptureRecorder
+{
+public:
+    static constexpr uint32_t fileMagic = 0x5043434d; // 'MCCP'
+    static constexpr uint32_t formatVersion = 2;
+
+    enum RecordType : uint32_t
+    {
+        prepareRecord = 1, // float64 sampleRate, int32 maxBlockSize, numChannels, bandOutputMask, reserved
+        blockRecord = 2,   // BlockHeader, parameter blob, MIDI events, audio (channel-major)
+        gapRecord = 3      // uint64 droppedBlocks
+    };
+
+    struct FileHeader
+    {
+        uint32_t magic = fileMagic;
+        uint32_t version = formatVersion;
+        uint32_t parameterBytes = 0;
+        uint32_t reserved = 0;
+    };
+
+    struct BlockHeader
+    {
+        int32_t numSamples = 0;
+        int32_t numChannels = 0;
+        float appliedLowMidHz = 0.0f;
+        float appliedMidHighHz = 0.0f;
+        uint64_t outputHash = 0;
+        int32_t numMidiEvents = 0;
+        int32_t midiBytes = 0; // each event: int32 offset, int32 size, data padded to 4
+    };
+
+    // Returns nullptr unless MULTICHAINER_CAPTURE is set. Each instance writes to its own
+    // file next to the requested one (name, name(2), ...).
+    static std::unique_ptr<CaptureRecorder> createFromEnvironment (size_t parameterBytes);
+
+    CaptureRecorder (const juce::File& requestedFile, size_t parameterBytes);
+    ~CaptureRecorder();
+
+    bool isOpen() const noexcept { return stream != nullptr; }
+
+    // Call from prepareToPlay (the audio thread is stopped).
+    // bandOutputMask has bit n set when band output bus n + 1 (Low, Mid, High) is enabled.
+    void recordPrepare (double sampleRate, int maxBlockSize, int numChannels, int bandOutputMask);
+
+    // Audio thread. beginBlock copies the unprocessed input, endBlock adds the output hash and
+    // publishes the record.
+    void beginBlock (const juce::AudioBuffer<float>& input,
+                     const juce::MidiBuffer& midi,
+                     const void* parameters,
+                     float appliedLowMidHz,
+                     float appliedMidHighHz) noexcept;
+    void endBlock (const juce::AudioBuffer<float>& output) noexcept;
+
+    // Audio thread. Counts a block that ran without being recorded (host bypass), so the next
+    // recorded block is preceded by a gap record like a dropped one.
+    void skipBlock() noexcept { ++unreportedDrops; }
+
+    size_t getHeapBytes() const noexcept { return isOpen() ? static_cast<size_t> (ringBytes) : 0; }
+
+    uint64_t getDroppedBlocks() const noexcept { return droppedBlocks.load (std::memory_order_relaxed); }
+
+    // 64-bit FNV-1a over the sample words; shared with the replay tool.
+    static uint64_t hashAudio (const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) noexcept;
+
+    static int padTo4 (int bytes) noexcept { return (bytes + 3) & ~3; }
+
+private:
+    static constexpr int ringBytes = 8 << 20;                 // ~20 s of 48 kHz stereo with MIDI
+    static constexpr int flushThresholdBytes = ringBytes / 16; // ~1.3 s
+
+    // Runs on the shared BackgroundWorkerPool; repeated requests coalesce into one pass.
+    class FlushTask final : public core::BackgroundWorkerPool::Task
+    {
+    public:
+        explicit FlushTask (CaptureRecorder& ownerIn);
+        void run() override;
+
+    private:
+        CaptureRecorder& owner;
+    };
+
+    struct Reservation
+    {
+        int start1 = 0;
+        int size1 = 0;
+        int start2 = 0;
+        int size2 = 0;
+        int totalBytes = 0;
+    };
+
+    bool reserve (int bytes, Reservation& reservation) noexcept;
+    void writeAt (const Reservation& reservation, int offset, const void* data, int bytes) noexcept;
+    void publish (int bytes) noexcept;
+    void drain();
+
+    const size_t parameterBytes;
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    juce::HeapBlock<char> ring;
+    juce::AbstractFifo fifo { ringBytes };
+
+    Reservation openBlock;
+    int openBlockHashOffset = -1; // -1 while no block record is being written
+
+    std::atomic<uint64_t> droppedBlocks { 0 };
+    uint64_t unreportedDrops = 0; // audio thread
+
+    juce::CriticalSection drainLock;
+    FlushTask flushTask;
+
+    JUCE_DECLARE_NON_COPYABLE (CaptureRecorder)
+};
+
+// Reads a capture file record by record; used by MultiChainerReplay.
+class CaptureReader
+{
+public:
+    struct Prepare
+    {
+        double sampleRate = 44100.0;
+        int maxBlockSize = 0;
+        int numChannels = 2;
+        int bandOutputMask = 0;
+    };
+
+    struct Block
+    {
+        CaptureRecorder::BlockHeader header;
+        juce::MemoryBlock parameters;
+        juce::MidiBuffer midi;
+        juce::AudioBuffer<float> audio;
+    };
+
+    enum class Next
+    {
+        prepare,
+        block,
+        gap,
+        end,
+        corrupt
+    };
+
+    explicit CaptureReader (std::unique_ptr<juce::InputStream> source);
+
+    bool isValid() const noexcept { return valid; }
+    size_t getParameterBytes() const noexcept { return header.parameterBytes; }
+
+    Next readNext();
+
+    const Prepare& getPrepare() const noexcept { return prepare; }
+    Block& getBlock() noexcept { return block; }
+    uint64_t getGapDroppedBlocks() const noexcept { return gapDroppedBlocks; }
+
+private:
+    bool readBlockPayload (int payloadBytes);
+
+    std::unique_ptr<juce::InputStream> input;
+    CaptureRecorder::FileHeader header;
+    bool valid = false;
+
+    Prepare prepare;
+    Block block;
+    uint64_t gapDroppedBlocks = 0;
+    juce::MemoryBlock scratch;
+};
+} // namespace multichainer::diagnostics
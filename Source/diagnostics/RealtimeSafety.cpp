@@ -0,0 +1,306 @@
+#include "RealtimeSafety.h"
+
+#if MULTICHAINER_ENABLE_RT_CHECKS && (JUCE_LINUX || JUCE_MAC)
+ #define MULTICHAINER_RT_HOOKS 1
+ #include <execinfo.h>
+ #include <pthread.h>
+#else
+ #define MULTICHAINER_RT_HOOKS 0
+#endif
+
+#include <new>
+
+#if MULTICHAINER_RT_HOOKS
+ #include "RealtimeSafetyHooks.h"
+#endif
+
+namespace multichainer::diagnostics
+{
+namespace
+{
+constexpr uint64_t logCapacity = 256;
+
+// Multi-producer / single-consumer ring. Producers claim a slot with a CAS on writeIndex
+// (dropping the record when the ring is full) and publish it through its ready flag.
+struct ViolationLog
+{
+    std::array<RealtimeSafety::Violation, logCapacity> records {};
+    std::array<std::atomic<bool>, logCapacity> ready {};
+
+    std::atomic<uint64_t> writeIndex { 0 };
+    std::atomic<uint64_t> readIndex { 0 };
+    std::atomic<uint64_t> total { 0 };
+    std::atomic<uint64_t> dropped { 0 };
+};
+
+constinit ViolationLog violationLog;
+
+const char* toString (RealtimeSafety::ViolationKind kind)
+{
+    switch (kind)
+    {
+        case RealtimeSafety::ViolationKind::allocation:   return "allocation";
+        case RealtimeSafety::ViolationKind::deallocation: return "deallocation";
+        case RealtimeSafety::ViolationKind::lock:         return "lock";
+        case RealtimeSafety::ViolationKind::systemCall:   return "system call";
+    }
+
+    return "unknown";
+}
+
+#if MULTICHAINER_RT_HOOKS
+// Per-thread state lives in a pthread key rather than thread_local: the hooks run inside
+// malloc, and lazily-initialised TLS in a dynamically loaded plugin may itself allocate.
+enum ThreadState : intptr_t
+{
+    notRealtime = 0,
+    realtime = 1,
+    reporting = 2 // inside the reporter; nested hits (e.g. from backtrace) are ignored
+};
+
+pthread_key_t threadStateKey {};
+std::atomic<bool> threadStateKeyReady { false };
+
+ThreadState getThreadState() noexcept
+{
+    if (! threadStateKeyReady.load (std::memory_order_acquire))
+        return notRealtime;
+
+    return static_cast<ThreadState> (reinterpret_cast<intptr_t> (pthread_getspecific (threadStateKey)));
+}
+
+void setThreadState (ThreadState state) noexcept
+{
+    if (threadStateKeyReady.load (std::memory_order_acquire))
+        pthread_setspecific (threadStateKey, reinterpret_cast<void*> (static_cast<intptr_t> (state)));
+}
+
+[[maybe_unused]] const bool hooksInstalled = []
+{
+    pthread_key_create (&threadStateKey, nullptr);
+    threadStateKeyReady.store (true, std::memory_order_release);
+
+    // backtrace() loads its unwinder on first use; do that now, not on the audio thread.
+    void* frames[4];
+    backtrace (frames, 4);
+
+    multichainer_rt_resolve_hooks();
+    return true;
+}();
+#endif
+} // namespace
+
+//==============================================================================
+RealtimeSafety::ScopedRealtimeSection::ScopedRealtimeSection() noexcept
+{
+#if MULTICHAINER_RT_HOOKS
+    wasRealtime = getThreadState() != notRealtime;
+
+    if (! wasRealtime)
+        setThreadState (realtime);
+#endif
+}
+
+RealtimeSafety::ScopedRealtimeSection::~ScopedRealtimeSection() noexcept
+{
+#if MULTICHAINER_RT_HOOKS
+    if (! wasRealtime)
+        setThreadState (notRealtime);
+#endif
+}
+
+bool RealtimeSafety::isRealtimeThread() noexcept
+{
+#if MULTICHAINER_RT_HOOKS
+    return getThreadState() == realtime;
+#else
+    return false;
+#endif
+}
+
+void RealtimeSafety::reportIfRealtime (ViolationKind kind, const char* function) noexcept
+{
+#if MULTICHAINER_RT_HOOKS
+    if (getThreadState() != realtime)
+        return;
+
+    setThreadState (reporting);
+
+    auto& log = violationLog;
+    log.total.fetch_add (1, std::memory_order_relaxed);
+
+    auto write = log.writeIndex.load (std::memory_order_relaxed);
+
+    for (;;)
+    {
+        if (write - log.readIndex.load (std::memory_order_acquire) >= logCapacity)
+        {
+            log.dropped.fetch_add (1, std::memory_order_relaxed);
+            setThreadState (realtime);
+            return;
+        }
+
+        if (log.writeIndex.compare_exchange_weak (write, write + 1, std::memory_order_acq_rel))
+            break;
+    }
+
+    const auto slot = static_cast<size_t> (write % logCapacity);
+    auto& record = log.records[slot];
+
+    record.kind = kind;
+    record.function = function;
+    record.threadId = juce::Thread::getCurrentThreadId();
+    record.timeMs = juce::Time::getMillisecondCounterHiRes();
+    record.numFrames = backtrace (record.frames, maxStackFrames);
+
+    log.ready[slot].store (true, std::memory_order_release);
+
+    setThreadState (realtime);
+#else
+    juce::ignoreUnused (kind, function);
+#endif
+}
+
+int RealtimeSafety::drainViolations (const std::function<void (const Violation&)>& callback)
+{
+    static juce::CriticalSection consumerLock;
+    const juce::ScopedLock lock (consumerLock);
+
+    auto& log = violationLog;
+    auto read = log.readIndex.load (std::memory_order_relaxed);
+    const auto write = log.writeIndex.load (std::memory_order_acquire);
+
+    auto drained = 0;
+
+    for (; read < write; ++read)
+    {
+        const auto slot = static_cast<size_t> (read % logCapacity);
+
+        if (! log.ready[slot].load (std::memory_order_acquire))
+            break;
+
+        const auto record = log.records[slot];
+        log.ready[slot].store (false, std::memory_order_relaxed);
+        log.readIndex.store (read + 1, std::memory_order_release);
+
+        if (callback != nullptr)
+            callback (record);
+
+        ++drained;
+    }
+
+    return drained;
+}
+
+void RealtimeSafety::logPendingViolations()
+{
+    drainViolations ([] (const Violation& violation)
+    {
+        juce::Logger::writeToLog (describe (violation));
+    });
+
+    if (const auto dropped = getNumDroppedViolations(); dropped > 0)
+        juce::Logger::writeToLog ("MultiChainer real-time log overflowed; " + juce::String (dropped) + " violation(s) dropped in total");
+}
+
+juce::String RealtimeSafety::describe (const Violation& violation)
+{
+    juce::String text;
+    text << "MultiChainer real-time violation: " << toString (violation.kind)
+         << " via " << violation.function
+         << " on audio thread " << juce::String::toHexString (reinterpret_cast<juce::pointer_sized_int> (violation.threadId))
+         << " at " << juce::String (violation.timeMs, 3) << " ms";
+
+#if MULTICHAINER_RT_HOOKS
+    if (violation.numFrames > 0)
+    {
+        if (auto* symbols = backtrace_symbols (violation.frames, violation.numFrames))
+        {
+            for (int frame = 0; frame < violation.numFrames; ++frame)
+                text << juce::newLine << "    " << symbols[frame];
+
+            std::free (symbols);
+        }
+    }
+#endif
+
+    return text;
+}
+
+uint64_t RealtimeSafety::getNumViolations() noexcept
+{
+    return violationLog.total.load (std::memory_order_relaxed);
+}
+
+uint64_t RealtimeSafety::getNumDroppedViolations() noexcept
+{
+    return violationLog.dropped.load (std::memory_order_relaxed);
+}
+} // namespace multichainer::diagnostics
+
+#if MULTICHAINER_RT_HOOKS
+//==============================================================================
+// C entry points used by RealtimeSafetyHooks.c.
+int multichainer_rt_is_realtime (void)
+{
+    return multichainer::diagnostics::RealtimeSafety::isRealtimeThread() ? 1 : 0;
+}
+
+void multichainer_rt_report (int kind, const char* function)
+{
+    using multichainer::diagnostics::RealtimeSafety;
+    RealtimeSafety::reportIfRealtime (static_cast<RealtimeSafety::ViolationKind> (kind), function);
+}
+
+//==============================================================================
+// Replacement allocation operators, so C++ allocations made by code in this binary reach
+// the malloc/free hooks instead of binding straight to the C++ runtime's allocator.
+void* operator new (std::size_t size)
+{
+    if (auto* pointer = std::malloc (size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return ::operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    void* pointer = nullptr;
+
+    if (posix_memalign (&pointer, juce::jmax (sizeof (void*), static_cast<std::size_t> (alignment)), size == 0 ? 1 : size) == 0)
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new (size, alignment);
+}
+
+void operator delete (void* pointer) noexcept                                    { std::free (pointer); }
+void operator delete[] (void* pointer) noexcept                                  { std::free (pointer); }
+void operator delete (void* pointer, std::size_t) noexcept                       { std::free (pointer); }
+void operator delete[] (void* pointer, std::size_t) noexcept                     { std::free (pointer); }
+void operator delete (void* pointer, const std::nothrow_t&) noexcept             { std::free (pointer); }
+void operator delete[] (void* pointer, const std::nothrow_t&) noexcept           { std::free (pointer); }
+void operator delete (void* pointer, std::align_val_t) noexcept                  { std::free (pointer); }
+void operator delete[] (void* pointer, std::align_val_t) noexcept                { std::free (pointer); }
+void operator delete (void* pointer, std::size_t, std::align_val_t) noexcept     { std::free (pointer); }
+void operator delete[] (void* pointer, std::size_t, std::align_val_t) noexcept   { std::free (pointer); }
+#endif
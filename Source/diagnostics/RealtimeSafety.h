@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MULTICHAINER_ENABLE_RT_CHECKS
+ #define MULTICHAINER_ENABLE_RT_CHECKS 0 // 1 = instrumented build, see RealtimeSafety.cpp
+#endif
+
+namespace multichainer::diagnostics
+{
+// Real-time-safety instrumentation. In builds with MULTICHAINER_ENABLE_RT_CHECKS=1, the
+// audio thread is marked for the duration of processBlock and allocation, lock and blocking
+// system-call entry points compiled into this binary are intercepted
+// (RealtimeSafetyHooks.c). Each hit on a marked thread is recorded with a stack trace into
+// a fixed-size lock-free log that is drained and symbolised off the audio thread.
+class RealtimeSafety
+{
+public:
+    enum class ViolationKind
+    {
+        allocation,
+        deallocation,
+        lock,
+        systemCall
+    };
+
+    static constexpr int maxStackFrames = 24;
+
+    struct Violation
+    {
+        ViolationKind kind = ViolationKind::allocation;
+        const char* function = "";
+        juce::Thread::ThreadID threadId = nullptr;
+        double timeMs = 0.0;
+        int numFrames = 0;
+        void* frames[maxStackFrames] {};
+    };
+
+    class ScopedRealtimeSection
+    {
+    public:
+        ScopedRealtimeSection() noexcept;
+        ~ScopedRealtimeSection() noexcept;
+
+    private:
+        bool wasRealtime = false;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeSection)
+    };
+
+    static bool isRealtimeThread() noexcept;
+    static void reportIfRealtime (ViolationKind kind, const char* function) noexcept;
+
+    // Not real-time safe: call from the message thread or a background thread.
+    static int drainViolations (const std::function<void (const Violation&)>& callback);
+    static void logPendingViolations();
+    static juce::String describe (const Violation& violation);
+
+    static uint64_t getNumViolations() noexcept;
+    static uint64_t getNumDroppedViolations() noexcept;
+};
+} // namespace multichainer::diagnostics
+
+#if MULTICHAINER_ENABLE_RT_CHECKS
+ #define MULTICHAINER_REALTIME_SECTION() \
+     const multichainer::diagnostics::RealtimeSafety::ScopedRealtimeSection multichainerRealtimeSection
+#else
+ #define MULTICHAINER_REALTIME_SECTION()
+#endif
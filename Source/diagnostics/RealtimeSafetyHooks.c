@@ -0,0 +1,229 @@
+/*
+    Interposed entry points for MULTICHAINER_ENABLE_RT_CHECKS builds (see RealtimeSafety.h).
+
+    Every definition here shadows the C library's for calls made from this binary: macOS binds
+    them locally through the two-level namespace and Linux links the instrumented plugin with
+    -Bsymbolic-functions. Each hook reports when the calling thread is inside a marked
+    real-time section and then forwards to the real implementation.
+
+    Written in C so the definitions need not match the C++ exception specifications the
+    system headers attach to these declarations.
+*/
+
+#if MULTICHAINER_ENABLE_RT_CHECKS && (defined (__linux__) || defined (__APPLE__))
+
+#undef _FORTIFY_SOURCE
+#ifndef _GNU_SOURCE
+ #define _GNU_SOURCE 1
+#endif
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "RealtimeSafetyHooks.h"
+
+#if defined (__APPLE__)
+ #include <malloc/malloc.h>
+#endif
+
+/* Must match RealtimeSafety::ViolationKind. */
+enum
+{
+    kindAllocation = 0,
+    kindDeallocation = 1,
+    kindLock = 2,
+    kindSystemCall = 3
+};
+
+#define MC_CHECK(kind, name)                          \
+    do                                                \
+    {                                                 \
+        if (multichainer_rt_is_realtime())            \
+            multichainer_rt_report ((kind), (name));  \
+    } while (0)
+
+/* Real implementations of the non-allocator hooks, resolved once at start-up. */
+static int (*realPthreadMutexLock) (pthread_mutex_t*);
+static int (*realPthreadCondWait) (pthread_cond_t*, pthread_mutex_t*);
+static int (*realPthreadCondTimedWait) (pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+static int (*realSchedYield) (void);
+static int (*realNanosleep) (const struct timespec*, struct timespec*);
+static int (*realUsleep) (useconds_t);
+static ssize_t (*realRead) (int, void*, size_t);
+static ssize_t (*realWrite) (int, const void*, size_t);
+
+#define MC_RESOLVE(pointer, name)                             \
+    do                                                        \
+    {                                                         \
+        if ((pointer) == NULL)                                \
+            *(void**) (&(pointer)) = dlsym (RTLD_NEXT, name); \
+    } while (0)
+
+void multichainer_rt_resolve_hooks (void)
+{
+    MC_RESOLVE (realPthreadMutexLock, "pthread_mutex_lock");
+    MC_RESOLVE (realPthreadCondWait, "pthread_cond_wait");
+    MC_RESOLVE (realPthreadCondTimedWait, "pthread_cond_timedwait");
+    MC_RESOLVE (realSchedYield, "sched_yield");
+    MC_RESOLVE (realNanosleep, "nanosleep");
+    MC_RESOLVE (realUsleep, "usleep");
+    MC_RESOLVE (realRead, "read");
+    MC_RESOLVE (realWrite, "write");
+}
+
+/* ---- Allocator ------------------------------------------------------------------------ */
+
+#if defined (__GLIBC__)
+extern void* __libc_malloc (size_t);
+extern void* __libc_calloc (size_t, size_t);
+extern void* __libc_realloc (void*, size_t);
+extern void* __libc_memalign (size_t, size_t);
+extern void __libc_free (void*);
+
+ #define MC_REAL_MALLOC(size)              __libc_malloc (size)
+ #define MC_REAL_CALLOC(count, size)       __libc_calloc ((count), (size))
+ #define MC_REAL_REALLOC(pointer, size)    __libc_realloc ((pointer), (size))
+ #define MC_REAL_MEMALIGN(alignment, size) __libc_memalign ((alignment), (size))
+ #define MC_REAL_FREE(pointer)             __libc_free (pointer)
+ #define MC_HAVE_ALLOCATOR_HOOKS 1
+#elif defined (__APPLE__)
+static void* appleRealloc (void* pointer, size_t size)
+{
+    malloc_zone_t* zone = pointer != NULL ? malloc_zone_from_ptr (pointer) : NULL;
+    return malloc_zone_realloc (zone != NULL ? zone : malloc_default_zone(), pointer, size);
+}
+
+static void appleFree (void* pointer)
+{
+    malloc_zone_t* zone = malloc_zone_from_ptr (pointer);
+
+    if (zone != NULL)
+        malloc_zone_free (zone, pointer);
+}
+
+ #define MC_REAL_MALLOC(size)              malloc_zone_malloc (malloc_default_zone(), (size))
+ #define MC_REAL_CALLOC(count, size)       malloc_zone_calloc (malloc_default_zone(), (count), (size))
+ #define MC_REAL_REALLOC(pointer, size)    appleRealloc ((pointer), (size))
+ #define MC_REAL_MEMALIGN(alignment, size) malloc_zone_memalign (malloc_default_zone(), (alignment), (size))
+ #define MC_REAL_FREE(pointer)             appleFree (pointer)
+ #define MC_HAVE_ALLOCATOR_HOOKS 1
+#else
+ #define MC_HAVE_ALLOCATOR_HOOKS 0
+#endif
+
+#if MC_HAVE_ALLOCATOR_HOOKS
+void* malloc (size_t size)
+{
+    MC_CHECK (kindAllocation, "malloc");
+    return MC_REAL_MALLOC (size);
+}
+
+void* calloc (size_t count, size_t size)
+{
+    MC_CHECK (kindAllocation, "calloc");
+    return MC_REAL_CALLOC (count, size);
+}
+
+void* realloc (void* pointer, size_t size)
+{
+    MC_CHECK (kindAllocation, "realloc");
+    return MC_REAL_REALLOC (pointer, size);
+}
+
+int posix_memalign (void** result, size_t alignment, size_t size)
+{
+    void* pointer;
+
+    MC_CHECK (kindAllocation, "posix_memalign");
+
+    pointer = MC_REAL_MEMALIGN (alignment, size);
+
+    if (pointer == NULL)
+        return ENOMEM;
+
+    *result = pointer;
+    return 0;
+}
+
+void* aligned_alloc (size_t alignment, size_t size)
+{
+    MC_CHECK (kindAllocation, "aligned_alloc");
+    return MC_REAL_MEMALIGN (alignment, size);
+}
+
+void free (void* pointer)
+{
+    if (pointer == NULL)
+        return;
+
+    MC_CHECK (kindDeallocation, "free");
+    MC_REAL_FREE (pointer);
+}
+#endif
+
+/* ---- Locks and blocking calls ----------------------------------------------------------- */
+
+int pthread_mutex_lock (pthread_mutex_t* mutex)
+{
+    MC_CHECK (kindLock, "pthread_mutex_lock");
+    MC_RESOLVE (realPthreadMutexLock, "pthread_mutex_lock");
+    return realPthreadMutexLock (mutex);
+}
+
+int pthread_cond_wait (pthread_cond_t* condition, pthread_mutex_t* mutex)
+{
+    MC_CHECK (kindLock, "pthread_cond_wait");
+    MC_RESOLVE (realPthreadCondWait, "pthread_cond_wait");
+    return realPthreadCondWait (condition, mutex);
+}
+
+int pthread_cond_timedwait (pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* deadline)
+{
+    MC_CHECK (kindLock, "pthread_cond_timedwait");
+    MC_RESOLVE (realPthreadCondTimedWait, "pthread_cond_timedwait");
+    return realPthreadCondTimedWait (condition, mutex, deadline);
+}
+
+/* juce::SpinLock::enter() yields once spinning fails, so this also catches contended spins. */
+int sched_yield (void)
+{
+    MC_CHECK (kindLock, "sched_yield");
+    MC_RESOLVE (realSchedYield, "sched_yield");
+    return realSchedYield();
+}
+
+int nanosleep (const struct timespec* duration, struct timespec* remaining)
+{
+    MC_CHECK (kindSystemCall, "nanosleep");
+    MC_RESOLVE (realNanosleep, "nanosleep");
+    return realNanosleep (duration, remaining);
+}
+
+int usleep (useconds_t microseconds)
+{
+    MC_CHECK (kindSystemCall, "usleep");
+    MC_RESOLVE (realUsleep, "usleep");
+    return realUsleep (microseconds);
+}
+
+ssize_t read (int fd, void* data, size_t size)
+{
+    MC_CHECK (kindSystemCall, "read");
+    MC_RESOLVE (realRead, "read");
+    return realRead (fd, data, size);
+}
+
+ssize_t write (int fd, const void* data, size_t size)
+{
+    MC_CHECK (kindSystemCall, "write");
+    MC_RESOLVE (realWrite, "write");
+    return realWrite (fd, data, size);
+}
+
+#endif
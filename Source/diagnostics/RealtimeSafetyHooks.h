@@ -0,0 +1,21 @@
+#pragma once
+
+/*
+    C interface between RealtimeSafetyHooks.c and RealtimeSafety.cpp. Only linked into
+    MULTICHAINER_ENABLE_RT_CHECKS builds on macOS and Linux.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Defined in RealtimeSafetyHooks.c: looks up the real implementations behind the hooks. */
+void multichainer_rt_resolve_hooks (void);
+
+/* Defined in RealtimeSafety.cpp. kind is a RealtimeSafety::ViolationKind. */
+int multichainer_rt_is_realtime (void);
+void multichainer_rt_report (int kind, const char* function);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,195 @@
+#include "StageProfiler.h"
+
+namespace multichainer::diagnostics
+{
+void StageProfiler::prepare (double sampleRateToUse) noexcept
+{
+    sampleRate.store (juce::jmax (1.0, sampleRateToUse), std::memory_order_relaxed);
+    resetStatistics();
+}
+
+void StageProfiler::addConsumer() noexcept
+{
+    numConsumers.fetch_add (1, std::memory_order_relaxed);
+}
+
+void StageProfiler::removeConsumer() noexcept
+{
+    const auto previous = numConsumers.fetch_sub (1, std::memory_order_relaxed);
+    jassert (previous > 0);
+    juce::ignoreUnused (previous);
+}
+
+void StageProfiler::record (Stage stage, uint64_t durationNs) noexcept
+{
+    auto& counters = stages[static_cast<size_t> (stage)];
+
+    counters.histogram[static_cast<size_t> (getBucketIndex (durationNs))].fetch_add (1, std::memory_order_relaxed);
+    counters.count.fetch_add (1, std::memory_order_relaxed);
+    counters.totalNs.fetch_add (durationNs, std::memory_order_relaxed);
+    storeMax (counters.maxNs, durationNs);
+}
+
+void StageProfiler::finishBlock (uint64_t durationNs, int numSamples) noexcept
+{
+    record (Stage::total, durationNs);
+
+    if (numSamples <= 0)
+        return;
+
+    const auto deadlineNs = static_cast<double> (numSamples) * 1.0e9 / sampleRate.load (std::memory_order_relaxed);
+    const auto loadPermille = static_cast<uint64_t> (static_cast<double> (durationNs) * 1000.0 / deadlineNs);
+
+    if (loadPermille >= 1000)
+        deadlineOverruns.fetch_add (1, std::memory_order_relaxed);
+
+    storeMax (worstLoadPermille, loadPermille);
+}
+
+StageProfiler::Snapshot StageProfiler::getSnapshot() const noexcept
+{
+    Snapshot snapshot;
+    snapshot.sampleRate = sampleRate.load (std::memory_order_relaxed);
+    snapshot.deadlineOverruns = deadlineOverruns.load (std::memory_order_relaxed);
+    snapshot.worstDeadlineLoad = static_cast<double> (worstLoadPermille.load (std::memory_order_relaxed)) / 1000.0;
+
+    for (size_t stage = 0; stage < stages.size(); ++stage)
+    {
+        const auto& counters = stages[stage];
+        auto& statistics = snapshot.stages[stage];
+
+        statistics.count = counters.count.load (std::memory_order_relaxed);
+        statistics.totalNs = counters.totalNs.load (std::memory_order_relaxed);
+        statistics.maxNs = counters.maxNs.load (std::memory_order_relaxed);
+
+        std::array<uint32_t, numHistogramBuckets> histogram {};
+        uint64_t histogramCount = 0;
+
+        for (size_t bucket = 0; bucket < histogram.size(); ++bucket)
+        {
+            histogram[bucket] = counters.histogram[bucket].load (std::memory_order_relaxed);
+            histogramCount += histogram[bucket];
+        }
+
+        const auto percentile = [&histogram, histogramCount] (double fraction)
+        {
+            const auto target = static_cast<uint64_t> (std::ceil (fraction * static_cast<double> (histogramCount)));
+            uint64_t seen = 0;
+
+            for (size_t bucket = 0; bucket < histogram.size(); ++bucket)
+            {
+                seen += histogram[bucket];
+
+                if (seen >= target && seen > 0)
+                    return getBucketUpperBoundNs (static_cast<int> (bucket));
+            }
+
+            return uint64_t { 0 };
+        };
+
+        statistics.p50Ns = juce::jmin (percentile (0.5), statistics.maxNs);
+        statistics.p99Ns = juce::jmin (percentile (0.99), statistics.maxNs);
+    }
+
+    snapshot.blocks = snapshot.stages[static_cast<size_t> (Stage::total)].count;
+    return snapshot;
+}
+
+void StageProfiler::resetStatistics() noexcept
+{
+    for (auto& counters : stages)
+    {
+        for (auto& bucket : counters.histogram)
+            bucket.store (0, std::memory_order_relaxed);
+
+        counters.count.store (0, std::memory_order_relaxed);
+        counters.totalNs.store (0, std::memory_order_relaxed);
+        counters.maxNs.store (0, std::memory_order_relaxed);
+    }
+
+    deadlineOverruns.store (0, std::memory_order_relaxed);
+    worstLoadPermille.store (0, std::memory_order_relaxed);
+}
+
+juce::var StageProfiler::toVar (const Snapshot& snapshot)
+{
+    juce::Array<juce::var> stageList;
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        const auto& statistics = snapshot.stages[static_cast<size_t> (stage)];
+
+        auto stageObject = std::make_unique<juce::DynamicObject>();
+        stageObject->setProperty ("name", getStageName (static_cast<Stage> (stage)));
+        stageObject->setProperty ("count", static_cast<juce::int64> (statistics.count));
+        stageObject->setProperty ("meanUs", statistics.count > 0 ? static_cast<double> (statistics.totalNs) / static_cast<double> (statistics.count) / 1000.0 : 0.0);
+        stageObject->setProperty ("p50Us", static_cast<double> (statistics.p50Ns) / 1000.0);
+        stageObject->setProperty ("p99Us", static_cast<double> (statistics.p99Ns) / 1000.0);
+        stageObject->setProperty ("maxUs", static_cast<double> (statistics.maxNs) / 1000.0);
+        stageList.add (juce::var (stageObject.release()));
+    }
+
+    auto object = std::make_unique<juce::DynamicObject>();
+    object->setProperty ("blocks", static_cast<juce::int64> (snapshot.blocks));
+    object->setProperty ("deadlineOverruns", static_cast<juce::int64> (snapshot.deadlineOverruns));
+    object->setProperty ("worstDeadlineLoad", snapshot.worstDeadlineLoad);
+    object->setProperty ("sampleRate", snapshot.sampleRate);
+    object->setProperty ("stages", juce::var (stageList));
+
+    return juce::var (object.release());
+}
+
+const char* StageProfiler::getStageName (Stage stage) noexcept
+{
+    switch (stage)
+    {
+        case Stage::parameters: return "parameters";
+        case Stage::midi:       return "midi";
+        case Stage::crossover:  return "crossover";
+        case Stage::ducker:     return "ducker";
+        case Stage::mix:        return "mix";
+        case Stage::analyzer:   return "analyzer";
+        case Stage::total:      return "total";
+    }
+
+    return "";
+}
+
+int StageProfiler::getBucketIndex (uint64_t durationNs) noexcept
+{
+    if (durationNs < (uint64_t { 1 } << subBucketBits))
+        return static_cast<int> (durationNs);
+
+    // Octave from the highest set bit, sub-bucket from the next subBucketBits bits.
+    auto octave = 0;
+    for (auto value = durationNs; value > 1; value >>= 1)
+        ++octave;
+
+    const auto subBucket = static_cast<int> ((durationNs >> (octave - subBucketBits)) & ((1u << subBucketBits) - 1));
+    const auto index = ((octave - subBucketBits + 1) << subBucketBits) + subBucket;
+
+    return juce::jmin (index, numHistogramBuckets - 1);
+}
+
+uint64_t StageProfiler::getBucketUpperBoundNs (int bucket) noexcept
+{
+    constexpr auto subBuckets = 1 << subBucketBits;
+
+    if (bucket < subBuckets)
+        return static_cast<uint64_t> (bucket + 1);
+
+    const auto octave = (bucket >> subBucketBits) + subBucketBits - 1;
+    const auto subBucket = static_cast<uint64_t> (bucket & (subBuckets - 1));
+
+    return (uint64_t { 1 } << octave) + ((subBucket + 1) << (octave - subBucketBits));
+}
+
+void StageProfiler::storeMax (std::atomic<uint64_t>& target, uint64_t value) noexcept
+{
+    auto current = target.load (std::memory_order_relaxed);
+
+    while (value > current && ! target.compare_exchange_weak (current, value, std::memory_order_relaxed))
+    {
+    }
+}
+} // namespace multichainer::diagnostics
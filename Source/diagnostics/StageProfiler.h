@@ -0,0 +1,140 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <chrono>
+
+namespace multichainer::diagnostics
+{
+// Per-stage processBlock timing. The audio thread only touches relaxed atomics, and only
+// while at least one consumer (the UI diagnostics panel, a tool) has called addConsumer();
+// otherwise a block costs one atomic load. Durations land in log-linear histograms
+// (4 sub-buckets per power of two), read on demand from any thread.
+class StageProfiler
+{
+public:
+    enum class Stage
+    {
+        parameters,
+        midi,
+        crossover,
+        ducker,
+        mix,
+        analyzer,
+        total
+    };
+
+    static constexpr int numStages = static_cast<int> (Stage::total) + 1;
+    static constexpr int subBucketBits = 2;
+    static constexpr int numHistogramBuckets = 32 << subBucketBits; // up to ~8 s per block
+
+    struct StageStatistics
+    {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t p50Ns = 0;
+        uint64_t p99Ns = 0;
+    };
+
+    struct Snapshot
+    {
+        std::array<StageStatistics, numStages> stages;
+        uint64_t blocks = 0;
+        uint64_t deadlineOverruns = 0;
+        double worstDeadlineLoad = 0.0; // total block time / (numSamples / sampleRate)
+        double sampleRate = 0.0;
+    };
+
+    // Started with StageProfiler::startBlock(); a no-op when profiling is off. A stage may be
+    // lapped several times per block (once per internal tile); its laps are summed and recorded
+    // as one sample when the block finishes.
+    class BlockTimer
+    {
+    public:
+        void lap (Stage stage) noexcept
+        {
+            if (owner == nullptr)
+                return;
+
+            const auto now = StageProfiler::now();
+            stageNs[static_cast<size_t> (stage)] += now - lastNs;
+            lastNs = now;
+        }
+
+        void finish (int numSamples) noexcept
+        {
+            if (owner == nullptr)
+                return;
+
+            for (size_t stage = 0; stage < stageNs.size() - 1; ++stage)
+                owner->record (static_cast<Stage> (stage), stageNs[stage]);
+
+            owner->finishBlock (StageProfiler::now() - blockStartNs, numSamples);
+        }
+
+    private:
+        friend class StageProfiler;
+
+        StageProfiler* owner = nullptr;
+        uint64_t blockStartNs = 0;
+        uint64_t lastNs = 0;
+        std::array<uint64_t, numStages> stageNs {};
+    };
+
+    void prepare (double sampleRateToUse) noexcept;
+
+    void addConsumer() noexcept;
+    void removeConsumer() noexcept;
+    bool isEnabled() const noexcept { return numConsumers.load (std::memory_order_relaxed) > 0; }
+
+    BlockTimer startBlock() noexcept
+    {
+        BlockTimer timer;
+
+        if (isEnabled())
+        {
+            timer.owner = this;
+            timer.blockStartNs = timer.lastNs = now();
+        }
+
+        return timer;
+    }
+
+    // Any thread. Counters may be mid-update, so totals across stages can differ by a block.
+    Snapshot getSnapshot() const noexcept;
+    void resetStatistics() noexcept;
+
+    static juce::var toVar (const Snapshot& snapshot);
+    static const char* getStageName (Stage stage) noexcept;
+
+    static uint64_t now() noexcept
+    {
+        return static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+    }
+
+private:
+    struct StageCounters
+    {
+        std::array<std::atomic<uint32_t>, numHistogramBuckets> histogram {};
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<uint64_t> totalNs { 0 };
+        std::atomic<uint64_t> maxNs { 0 };
+    };
+
+    void record (Stage stage, uint64_t durationNs) noexcept;
+    void finishBlock (uint64_t durationNs, int numSamples) noexcept;
+
+    static int getBucketIndex (uint64_t durationNs) noexcept;
+    static uint64_t getBucketUpperBoundNs (int bucket) noexcept;
+    static void storeMax (std::atomic<uint64_t>& target, uint64_t value) noexcept;
+
+    std::array<StageCounters, numStages> stages;
+    std::atomic<uint64_t> deadlineOverruns { 0 };
+    std::atomic<uint64_t> worstLoadPermille { 0 };
+    std::atomic<int> numConsumers { 0 };
+    std::atomic<double> sampleRate { 44100.0 };
+};
+} // namespace multichainer::diagnostics
@@ -0,0 +1,269 @@
+#include "TraceRecorder.h"
+
+#if MULTICHAINER_ENABLE_TRACING
+
+#include <chrono>
+
+namespace multichainer::diagnostics
+{
+namespace
+{
+constexpr uint32_t eventsPerThread = 8192; // power of two
+constexpr int maxTracedThreads = 32;
+
+struct TraceEvent
+{
+    uint64_t timestampNs = 0;
+    const char* name = "";
+    juce::int64 value = 0;
+    TraceRecorder::Phase phase = TraceRecorder::Phase::instant;
+};
+
+uint64_t nowNs() noexcept
+{
+    return static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (
+                                      std::chrono::steady_clock::now().time_since_epoch())
+                                      .count());
+}
+
+// Single producer (the owning thread), single consumer (the drain thread).
+struct ThreadBuffer
+{
+    std::array<TraceEvent, eventsPerThread> events {};
+    std::atomic<uint32_t> writeIndex { 0 };
+    std::atomic<uint32_t> readIndex { 0 };
+    std::atomic<uint64_t> dropped { 0 };
+    std::atomic<const char*> threadName { nullptr };
+
+    int threadIndex = 0;
+    bool threadNameWritten = false; // drain thread only
+
+    void push (TraceRecorder::Phase phase, const char* name, juce::int64 value) noexcept
+    {
+        const auto write = writeIndex.load (std::memory_order_relaxed);
+
+        if (write - readIndex.load (std::memory_order_acquire) >= eventsPerThread)
+        {
+            dropped.fetch_add (1, std::memory_order_relaxed);
+            return;
+        }
+
+        events[write & (eventsPerThread - 1)] = { nowNs(), name, value, phase };
+        writeIndex.store (write + 1, std::memory_order_release);
+    }
+};
+
+class TraceSession;
+std::atomic<TraceSession*> activeSession { nullptr };
+
+class TraceSession final : private juce::Thread
+{
+public:
+    explicit TraceSession (const juce::File& fileToWrite)
+        : juce::Thread ("MultiChainer Trace Writer"),
+          file (fileToWrite),
+          startNs (nowNs())
+    {
+        for (int index = 0; index < maxTracedThreads; ++index)
+        {
+            buffers[static_cast<size_t> (index)] = std::make_unique<ThreadBuffer>();
+            buffers[static_cast<size_t> (index)]->threadIndex = index + 1;
+        }
+
+        file.deleteFile();
+        stream = file.createOutputStream();
+
+        if (stream == nullptr)
+            return;
+
+        *stream << "[\n";
+        startThread (juce::Thread::Priority::low);
+    }
+
+    ~TraceSession() override
+    {
+        activeSession.store (nullptr, std::memory_order_release);
+        stopThread (1000);
+        drain();
+
+        if (stream != nullptr)
+        {
+            *stream << "{\"name\":\"traceEnd\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << toMicroseconds (nowNs())
+                    << ",\"pid\":1,\"tid\":0}\n]\n";
+            stream->flush();
+        }
+    }
+
+    bool isOpen() const noexcept { return stream != nullptr; }
+
+    ThreadBuffer* claimBuffer() noexcept
+    {
+        const auto index = nextBuffer.fetch_add (1, std::memory_order_relaxed);
+
+        if (index >= maxTracedThreads)
+            return nullptr;
+
+        return buffers[static_cast<size_t> (index)].get();
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (100);
+            drain();
+        }
+    }
+
+    juce::String toMicroseconds (uint64_t timestampNs) const
+    {
+        return juce::String (static_cast<double> (timestampNs - startNs) / 1000.0, 3);
+    }
+
+    void drain()
+    {
+        const juce::ScopedLock lock (drainLock);
+
+        if (stream == nullptr)
+            return;
+
+        const auto claimed = juce::jmin (maxTracedThreads, nextBuffer.load (std::memory_order_relaxed));
+
+        for (int index = 0; index < claimed; ++index)
+        {
+            auto& buffer = *buffers[static_cast<size_t> (index)];
+
+            if (const auto* threadName = buffer.threadName.load (std::memory_order_acquire); threadName != nullptr && ! buffer.threadNameWritten)
+            {
+                *stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.threadIndex
+                        << ",\"args\":{\"name\":" << juce::JSON::toString (juce::String (threadName)) << "}},\n";
+                buffer.threadNameWritten = true;
+            }
+
+            const auto write = buffer.writeIndex.load (std::memory_order_acquire);
+            auto read = buffer.readIndex.load (std::memory_order_relaxed);
+
+            for (; read != write; ++read)
+            {
+                const auto& event = buffer.events[read & (eventsPerThread - 1)];
+
+                *stream << "{\"name\":\"" << event.name << "\",\"ph\":\"" << juce::String::charToString (static_cast<char> (event.phase))
+                        << "\",\"ts\":" << toMicroseconds (event.timestampNs) << ",\"pid\":1,\"tid\":" << buffer.threadIndex;
+
+                if (event.phase == TraceRecorder::Phase::instant)
+                    *stream << ",\"s\":\"t\"";
+
+                if (event.phase != TraceRecorder::Phase::end && event.value != 0)
+                    *stream << ",\"args\":{\"value\":" << juce::String (event.value) << "}";
+
+                *stream << "},\n";
+            }
+
+            buffer.readIndex.store (read, std::memory_order_release);
+
+            if (const auto dropped = buffer.dropped.exchange (0, std::memory_order_relaxed); dropped > 0)
+                *stream << "{\"name\":\"droppedEvents\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << toMicroseconds (nowNs())
+                        << ",\"pid\":1,\"tid\":" << buffer.threadIndex << ",\"args\":{\"value\":" << juce::String (static_cast<juce::int64> (dropped)) << "}},\n";
+        }
+
+        stream->flush();
+    }
+
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    const uint64_t startNs;
+
+    std::array<std::unique_ptr<ThreadBuffer>, maxTracedThreads> buffers;
+    std::atomic<int> nextBuffer { 0 };
+    juce::CriticalSection drainLock;
+};
+
+// Buffers are claimed on a thread's first event; threads past maxTracedThreads stay untraced.
+// Note: first use of a thread_local in a dlopen()ed plugin may allocate on some platforms,
+// which is acceptable for this opt-in debugging build.
+ThreadBuffer* getThreadBuffer (TraceSession& session) noexcept
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    thread_local bool claimed = false;
+
+    if (! claimed)
+    {
+        buffer = session.claimBuffer();
+        claimed = true;
+    }
+
+    return buffer;
+}
+} // namespace
+
+void TraceRecorder::initialise()
+{
+    static const auto session = []
+    {
+        const auto path = juce::SystemStats::getEnvironmentVariable ("MULTICHAINER_TRACE", {});
+
+        if (path.isEmpty())
+            return std::unique_ptr<TraceSession>();
+
+        auto newSession = std::make_unique<TraceSession> (juce::File::getCurrentWorkingDirectory().getChildFile (path));
+
+        if (! newSession->isOpen())
+            return std::unique_ptr<TraceSession>();
+
+        return newSession;
+    }();
+
+    activeSession.store (session.get(), std::memory_order_release);
+}
+
+bool TraceRecorder::isActive() noexcept
+{
+    return activeSession.load (std::memory_order_relaxed) != nullptr;
+}
+
+void TraceRecorder::record (Phase phase, const char* name, juce::int64 value) noexcept
+{
+    auto* session = activeSession.load (std::memory_order_acquire);
+
+    if (session == nullptr)
+        return;
+
+    if (auto* buffer = getThreadBuffer (*session))
+        buffer->push (phase, name, value);
+}
+
+void TraceRecorder::setCurrentThreadName (const char* name) noexcept
+{
+    auto* session = activeSession.load (std::memory_order_acquire);
+
+    if (session == nullptr)
+        return;
+
+    if (auto* buffer = getThreadBuffer (*session); buffer != nullptr && buffer->threadName.load (std::memory_order_relaxed) == nullptr)
+        buffer->threadName.store (name, std::memory_order_release);
+}
+
+TraceRecorder::ScopedEvent::ScopedEvent (const char* eventName, juce::int64 value) noexcept
+    : name (eventName)
+{
+    record (Phase::begin, name, value);
+}
+
+TraceRecorder::ScopedEvent::~ScopedEvent() noexcept
+{
+    record (Phase::end, name);
+}
+} // namespace multichainer::diagnostics
+
+#else
+
+namespace multichainer::diagnostics
+{
+void TraceRecorder::initialise() {}
+bool TraceRecorder::isActive() noexcept { return false; }
+void TraceRecorder::record (Phase, const char*, juce::int64) noexcept {}
+void TraceRecorder::setCurrentThreadName (const char*) noexcept {}
+} // namespace multichainer::diagnostics
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MULTICHAINER_ENABLE_TRACING
+ #define MULTICHAINER_ENABLE_TRACING 0 // 1 = compile trace points in, see TraceRecorder.cpp
+#endif
+
+namespace multichainer::diagnostics
+{
+// Optional Chrome/Perfetto trace export. In builds with MULTICHAINER_ENABLE_TRACING=1, a
+// session starts when the MULTICHAINER_TRACE environment variable names an output file.
+// Each thread writes events into its own preallocated single-producer ring (wait-free, drops
+// when full) and a background thread drains them to a trace-event JSON array, which
+// chrome://tracing and ui.perfetto.dev load even if the process dies mid-session.
+class TraceRecorder
+{
+public:
+    enum class Phase : char
+    {
+        begin = 'B',
+        end = 'E',
+        instant = 'i',
+        counter = 'C'
+    };
+
+    class ScopedEvent
+    {
+    public:
+        explicit ScopedEvent (const char* eventName, juce::int64 value = 0) noexcept;
+        ~ScopedEvent() noexcept;
+
+    private:
+        const char* name;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+    };
+
+    // Starts the process-wide session if requested. Allocates and opens the file, so call it
+    // from a non-realtime thread (the processor constructor does) before any trace points run.
+    static void initialise();
+
+    static bool isActive() noexcept;
+
+    // `name` must be a string literal or otherwise outlive the session.
+    static void record (Phase phase, const char* name, juce::int64 value = 0) noexcept;
+    static void setCurrentThreadName (const char* name) noexcept;
+};
+} // namespace multichainer::diagnostics
+
+#if MULTICHAINER_ENABLE_TRACING
+ #define MULTICHAINER_TRACE_SCOPE(name) \
+     const multichainer::diagnostics::TraceRecorder::ScopedEvent JUCE_JOIN_MACRO (multichainerTraceScope, __LINE__) (name)
+ #define MULTICHAINER_TRACE_SCOPE_VALUE(name, value) \
+     const multichainer::diagnostics::TraceRecorder::ScopedEvent JUCE_JOIN_MACRO (multichainerTraceScope, __LINE__) (name, value)
+ #define MULTICHAINER_TRACE_INSTANT(name, value) \
+     multichainer::diagnostics::TraceRecorder::record (multichainer::diagnostics::TraceRecorder::Phase::instant, name, value)
+ #define MULTICHAINER_TRACE_THREAD_NAME(name) \
+     multichainer::diagnostics::TraceRecorder::setCurrentThreadName (name)
+#else
+ #define MULTICHAINER_TRACE_SCOPE(name)
+ #define MULTICHAINER_TRACE_SCOPE_VALUE(name, value)
+ #define MULTICHAINER_TRACE_INSTANT(name, value)
+ #define MULTICHAINER_TRACE_THREAD_NAME(name)
+#endif
@@ -0,0 +1,211 @@
+#include "CoefficientCache.h"
+
+#include "CoefficientDiskCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace multichainer::dsp
+{
+namespace
+{
+constexpr float minimumCutoffHz = 20.0f;
+
+template <typename Target, typename Source>
+Target bitsOf (Source value) noexcept
+{
+    static_assert (sizeof (Target) == sizeof (Source));
+
+    Target bits;
+    std::memcpy (&bits, &value, sizeof (bits));
+    return bits;
+}
+} // namespace
+
+CoefficientKey CoefficientKey::make (double sampleRate, int tapCount, float cutoffHz, DesignQuality quality) noexcept
+{
+    return { bitsOf<uint64_t> (sampleRate), bitsOf<uint32_t> (cutoffHz), tapCount, quality };
+}
+
+CoefficientCache& CoefficientCache::getInstance()
+{
+    static CoefficientCache instance;
+    return instance;
+}
+
+CoefficientCache::CoefficientCache()
+{
+#if MULTICHAINER_ENABLE_DISK_COEFFICIENT_CACHE
+    diskCache = std::make_unique<CoefficientDiskCache> (CoefficientDiskCache::getDefaultFile());
+#endif
+}
+
+CoefficientCache::~CoefficientCache() = default;
+
+CoefficientCache::Design CoefficientCache::getLowpass (double sampleRate,
+                                                      int tapCount,
+                                                      float cutoffHz,
+                                                      bool persistToDisk,
+                                                      DesignQuality quality)
+{
+    const auto key = CoefficientKey::make (sampleRate, tapCount, cutoffHz, quality);
+    const auto useDiskCache = diskCache != nullptr && quality == DesignQuality::standard;
+
+    {
+        const std::lock_guard<std::mutex> guard (lock);
+
+        if (const auto existing = entries.find (key); existing != entries.end())
+            if (auto design = existing->second.lock())
+                return design;
+    }
+
+    // Design (or map) outside the lock so concurrent designers for different keys do not
+    // serialise.
+    Design design = useDiskCache ? diskCache->find (key) : nullptr;
+
+    if (design == nullptr)
+    {
+        auto fresh = std::make_shared<CoefficientSet>();
+        fresh->sampleRate = sampleRate;
+        fresh->tapCount = tapCount;
+        fresh->cutoffHz = cutoffHz;
+        fresh->coefficients.assign (static_cast<size_t> (tapCount), 0.0f);
+        fresh->firstActiveTap = designKaiserLowpass (fresh->coefficients, cutoffHz, sampleRate, quality);
+        design = std::move (fresh);
+
+        if (persistToDisk && useDiskCache)
+            diskCache->add (key, design);
+    }
+
+    const std::lock_guard<std::mutex> guard (lock);
+
+    // Another thread may have designed the same key meanwhile; keep whichever landed first.
+    auto& entry = entries[key];
+
+    if (auto winner = entry.lock())
+        return winner;
+
+    entry = design;
+
+    if (entries.size() > pruneThreshold)
+        pruneExpiredEntries();
+
+    return design;
+}
+
+int CoefficientCache::getNumLiveDesigns() const
+{
+    const std::lock_guard<std::mutex> guard (lock);
+
+    return static_cast<int> (std::count_if (entries.begin(), entries.end(), [] (const auto& entry)
+    {
+        return ! entry.second.expired();
+    }));
+}
+
+void CoefficientCache::pruneExpiredEntries()
+{
+    for (auto it = entries.begin(); it != entries.end();)
+        it = it->second.expired() ? entries.erase (it) : std::next (it);
+
+    // Sweep again only after the live set has doubled, keeping pruning amortised O(1).
+    pruneThreshold = juce::jmax (size_t { 64 }, entries.size() * 2);
+}
+
+uint32_t CoefficientCache::getDesignId() noexcept
+{
+    // Bump the leading constant when the design algorithm itself changes.
+    constexpr uint32_t algorithmVersion = 1;
+
+    return algorithmVersion * 1000003u
+           ^ static_cast<uint32_t> (transitionOctaves * 1000.0) * 7919u
+           ^ static_cast<uint32_t> (stopbandAttenuationDb * 1000.0);
+}
+
+int CoefficientCache::designKaiserLowpass (std::vector<float>& coefficients,
+                                           float cutoffHz,
+                                           double sampleRateValue,
+                                           DesignQuality quality)
+{
+    if (coefficients.empty())
+        return 0;
+
+    const auto economy = quality == DesignQuality::economy;
+    const auto octaves = economy ? economyTransitionOctaves : transitionOctaves;
+    const auto attenuationDb = economy ? economyStopbandAttenuationDb : stopbandAttenuationDb;
+
+    std::fill (coefficients.begin(), coefficients.end(), 0.0f);
+
+    const auto taps = static_cast<int> (coefficients.size());
+    const auto maxHalfLength = (taps - 1) / 2;
+    const auto nyquist = sampleRateValue * 0.5;
+    const auto clampedCutoff = juce::jlimit (static_cast<double> (minimumCutoffHz),
+                                             sampleRateValue * 0.49,
+                                             static_cast<double> (cutoffHz));
+
+    // Transition from cutoff / 2^(w/2) to cutoff * 2^(w/2), narrowed near Nyquist so the
+    // stopband edge stays in range.
+    const auto octaveSpread = std::pow (2.0, octaves * 0.5);
+    const auto stopbandEdge = juce::jmin (clampedCutoff * octaveSpread, nyquist);
+    const auto transitionHz = juce::jmax (1.0, juce::jmin (stopbandEdge - clampedCutoff / octaveSpread,
+                                                           2.0 * (stopbandEdge - clampedCutoff)));
+    const auto transitionRadians = 2.0 * juce::MathConstants<double>::pi * transitionHz / sampleRateValue;
+
+    // Kaiser's length and beta estimates.
+    const auto requiredLength = (attenuationDb - 7.95) / (2.285 * transitionRadians) + 1.0;
+    const auto halfLength = juce::jlimit (0, maxHalfLength, static_cast<int> (std::ceil ((requiredLength - 1.0) * 0.5)));
+    const auto beta = attenuationDb > 50.0 ? 0.1102 * (attenuationDb - 8.7)
+                                           : 0.5842 * std::pow (attenuationDb - 21.0, 0.4)
+                                                 + 0.07886 * (attenuationDb - 21.0);
+
+    const auto firstActiveTap = maxHalfLength - halfLength;
+    const auto fc = clampedCutoff / sampleRateValue;
+
+    const auto besselI0 = [] (double x)
+    {
+        // Power series; converges quickly for the beta range used here.
+        double sum = 1.0;
+        double term = 1.0;
+
+        for (int k = 1; k < 64 && term > 1.0e-12 * sum; ++k)
+        {
+            const auto factor = x / (2.0 * static_cast<double> (k));
+            term *= factor * factor;
+            sum += term;
+        }
+
+        return sum;
+    };
+
+    const auto windowNormalisation = besselI0 (beta);
+    double normalisation = 0.0;
+
+    for (int offset = -halfLength; offset <= halfLength; ++offset)
+    {
+        const auto x = 2.0 * fc * static_cast<double> (offset);
+
+        double sinc = 1.0;
+        if (std::abs (x) > 1.0e-12)
+            sinc = std::sin (juce::MathConstants<double>::pi * x)
+                   / (juce::MathConstants<double>::pi * x);
+
+        const auto ratio = halfLength > 0 ? static_cast<double> (offset) / static_cast<double> (halfLength) : 0.0;
+        const auto window = besselI0 (beta * std::sqrt (juce::jmax (0.0, 1.0 - ratio * ratio))) / windowNormalisation;
+
+        const auto value = 2.0 * fc * sinc * window;
+        coefficients[static_cast<size_t> (maxHalfLength + offset)] = static_cast<float> (value);
+        normalisation += value;
+    }
+
+    if (normalisation != 0.0)
+    {
+        const auto invNormalisation = static_cast<float> (1.0 / normalisation);
+
+        for (auto& coefficient : coefficients)
+            coefficient *= invNormalisation;
+    }
+
+    return firstActiveTap;
+}
+} // namespace multichainer::dsp
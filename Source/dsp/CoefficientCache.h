@@ -0,0 +1,120 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace multichainer::dsp
+{
+// One immutable FIR lowpass design. Shared between every crossover that asks for the same
+// (sample rate, tap count, cutoff), and never modified after construction, so audio threads
+// read it without synchronisation.
+//
+// The kernel may be shorter than tapCount: it is centred in the buffer and the taps before
+// firstActiveTap (and the mirrored ones after tapCount - 1 - firstActiveTap) are zero, so the
+// group delay is always (tapCount - 1) / 2 and filters in one crossover stay phase aligned.
+struct CoefficientSet
+{
+    double sampleRate = 0.0;
+    int tapCount = 0;
+    int firstActiveTap = 0;
+    float cutoffHz = 0.0f;
+
+    // Either owned here, or read-only pages of the on-disk cache kept alive by `mapping`.
+    std::vector<float> coefficients;
+    const float* mappedCoefficients = nullptr;
+    std::shared_ptr<const juce::MemoryMappedFile> mapping;
+
+    const float* getCoefficients() const noexcept
+    {
+        return mappedCoefficients != nullptr ? mappedCoefficients : coefficients.data();
+    }
+};
+
+// Standard designs meet CoefficientCache's full design target. Economy designs (the CPU
+// governor's fallback) use a wider transition band and shallower stopband, which shortens
+// their kernels (to about a third where neither is capped) at the same tap count and latency.
+enum class DesignQuality : uint32_t
+{
+    standard,
+    economy
+};
+
+// Identifies a design. Compared bitwise, so a request hits exactly when it would design the
+// same coefficients.
+struct CoefficientKey
+{
+    uint64_t sampleRateBits = 0;
+    uint32_t cutoffBits = 0;
+    int tapCount = 0;
+    DesignQuality quality = DesignQuality::standard;
+
+    static CoefficientKey make (double sampleRate, int tapCount, float cutoffHz, DesignQuality quality) noexcept;
+
+    bool operator< (const CoefficientKey& other) const noexcept
+    {
+        return std::tie (sampleRateBits, cutoffBits, tapCount, quality)
+               < std::tie (other.sampleRateBits, other.cutoffBits, other.tapCount, other.quality);
+    }
+};
+
+class CoefficientDiskCache;
+
+// Process-wide cache of lowpass designs. Entries are weak, so a design lives exactly as long
+// as some crossover holds it; identical instances (templates, stacked tracks) share one copy
+// and skip the design work. Misses consult the on-disk cache (when built in) before designing.
+// Lookups lock a mutex and may design, so call them only from prepare() or a designer thread,
+// never from process().
+class CoefficientCache
+{
+public:
+    using Design = std::shared_ptr<const CoefficientSet>;
+
+    static CoefficientCache& getInstance();
+
+    // persistToDisk records a fresh design in the on-disk cache. Pass it for designs needed
+    // at prepare time, not for every intermediate value of an automated crossover. Economy
+    // designs are cheap to compute and never touch the on-disk cache.
+    Design getLowpass (double sampleRate,
+                       int tapCount,
+                       float cutoffHz,
+                       bool persistToDisk,
+                       DesignQuality quality = DesignQuality::standard);
+
+    int getNumLiveDesigns() const;
+
+    // Kaiser-window design target: transition band this many octaves wide, centred on the
+    // cutoff, with this much stopband attenuation.
+    static constexpr double transitionOctaves = 1.0;
+    static constexpr double stopbandAttenuationDb = 90.0;
+
+    static constexpr double economyTransitionOctaves = 2.0;
+    static constexpr double economyStopbandAttenuationDb = 60.0;
+
+    // Designs the shortest odd-length Kaiser-windowed sinc meeting the target (capped at
+    // coefficients.size()), centred in `coefficients`. Returns the first non-zero tap.
+    static int designKaiserLowpass (std::vector<float>& coefficients,
+                                    float cutoffHz,
+                                    double sampleRate,
+                                    DesignQuality quality = DesignQuality::standard);
+
+    // Changes whenever the design target above changes, invalidating persisted designs.
+    static uint32_t getDesignId() noexcept;
+
+    ~CoefficientCache();
+
+private:
+    CoefficientCache();
+
+    void pruneExpiredEntries();
+
+    mutable std::mutex lock;
+    std::map<CoefficientKey, std::weak_ptr<const CoefficientSet>> entries;
+    size_t pruneThreshold = 64;
+    std::unique_ptr<CoefficientDiskCache> diskCache;
+
+    JUCE_DECLARE_NON_COPYABLE (CoefficientCache)
+};
+} // namespace multichainer::dsp
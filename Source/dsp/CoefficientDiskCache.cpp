@@ -0,0 +1,297 @@
+#include "CoefficientDiskCache.h"
+
+#include <cstring>
+
+namespace multichainer::dsp
+{
+namespace
+{
+template <typename Target, typename Source>
+Target fromBits (Source bits) noexcept
+{
+    static_assert (sizeof (Target) == sizeof (Source));
+
+    Target value;
+    std::memcpy (&value, &bits, sizeof (value));
+    return value;
+}
+
+size_t alignUp (size_t bytes, size_t alignment) noexcept
+{
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+} // namespace
+
+CoefficientDiskCache::FlushTask::FlushTask (CoefficientDiskCache& ownerIn)
+    : Task (core::BackgroundWorkerPool::Priority::low),
+      owner (ownerIn)
+{
+}
+
+CoefficientDiskCache::CoefficientDiskCache (juce::File fileToUse)
+    : file (std::move (fileToUse)),
+      pool (core::BackgroundWorkerPool::getInstance()), // outlives this cache as a static
+      flushTask (*this)
+{
+    openMapping();
+}
+
+CoefficientDiskCache::~CoefficientDiskCache()
+{
+    pool.cancel (flushTask);
+    flush();
+}
+
+juce::File CoefficientDiskCache::getDefaultFile()
+{
+#if JUCE_MAC
+    const auto root = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory).getChildFile ("Application Support");
+#else
+    const auto root = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory);
+#endif
+
+    return root.getChildFile ("MultiChainer").getChildFile ("CoefficientCache-v1.bin");
+}
+
+std::shared_ptr<const CoefficientSet> CoefficientDiskCache::find (const CoefficientKey& key) const
+{
+    // The mapped set is immutable after construction, so it is read without locking.
+    if (const auto mapped = mappedEntries.find (key); mapped != mappedEntries.end())
+    {
+        if (auto design = checkedDesign (mapped->second))
+            return design;
+    }
+
+    const std::lock_guard<std::mutex> guard (pendingLock);
+
+    if (const auto pending = pendingEntries.find (key); pending != pendingEntries.end())
+    {
+        const auto& entry = pending->second;
+
+        auto design = std::make_shared<CoefficientSet>();
+        design->sampleRate = entry.sampleRate;
+        design->tapCount = key.tapCount;
+        design->firstActiveTap = entry.firstActiveTap;
+        design->cutoffHz = entry.cutoffHz;
+        design->coefficients = entry.coefficients;
+        return design;
+    }
+
+    return nullptr;
+}
+
+void CoefficientDiskCache::add (const CoefficientKey& key, std::shared_ptr<const CoefficientSet> design)
+{
+    if (design == nullptr || mappedEntries.size() >= maxEntries)
+        return;
+
+    {
+        const std::lock_guard<std::mutex> guard (pendingLock);
+
+        if (writeFailed
+            || mappedEntries.size() + pendingEntries.size() >= maxEntries
+            || pendingEntries.find (key) != pendingEntries.end())
+        {
+            return;
+        }
+
+        PendingEntry entry;
+        entry.sampleRate = design->sampleRate;
+        entry.cutoffHz = design->cutoffHz;
+        entry.firstActiveTap = design->firstActiveTap;
+        entry.coefficients.assign (design->getCoefficients(), design->getCoefficients() + key.tapCount);
+
+        pendingEntries.emplace (key, std::move (entry));
+        hasUnwrittenDesigns = true;
+    }
+
+    pool.schedule (flushTask);
+}
+
+void CoefficientDiskCache::flush()
+{
+    const std::lock_guard<std::mutex> flushGuard (flushLock);
+
+    // Written designs stay pending: the next write rebuilds the whole file from the mapping
+    // opened at start-up plus everything added since.
+    std::map<CoefficientKey, PendingEntry> pending;
+
+    {
+        const std::lock_guard<std::mutex> guard (pendingLock);
+
+        if (! hasUnwrittenDesigns || writeFailed)
+            return;
+
+        hasUnwrittenDesigns = false;
+        pending = pendingEntries;
+    }
+
+    struct Block
+    {
+        int firstActiveTap = 0;
+        const float* coefficients = nullptr;
+    };
+
+    std::map<CoefficientKey, Block> entries;
+
+    for (const auto& [key, entry] : pending)
+        entries.emplace (key, Block { entry.firstActiveTap, entry.coefficients.data() });
+
+    // Blocks that fail their checksum are dropped; a fresh design of the key may be pending.
+    // Mapped designs live as long as this cache, so their pages can be read directly.
+    for (const auto& [key, mapped] : mappedEntries)
+        if (const auto design = checkedDesign (mapped))
+            entries.emplace (key, Block { design->firstActiveTap, design->getCoefficients() });
+
+    // Lay out header, index and aligned coefficient blocks, then fill them in.
+    const auto indexOffset = sizeof (FileHeader);
+    auto dataOffset = alignUp (indexOffset + entries.size() * sizeof (IndexEntry), dataAlignment);
+
+    std::vector<IndexEntry> index;
+    index.reserve (entries.size());
+
+    for (const auto& [key, block] : entries)
+    {
+        IndexEntry entry;
+        entry.sampleRateBits = key.sampleRateBits;
+        entry.cutoffBits = key.cutoffBits;
+        entry.tapCount = key.tapCount;
+        entry.firstActiveTap = block.firstActiveTap;
+        entry.dataOffset = dataOffset;
+        entry.dataChecksum = checksum (block.coefficients, static_cast<size_t> (key.tapCount) * sizeof (float));
+        index.push_back (entry);
+
+        dataOffset = alignUp (dataOffset + static_cast<size_t> (key.tapCount) * sizeof (float), dataAlignment);
+    }
+
+    juce::MemoryBlock image (dataOffset, true);
+    auto* bytes = static_cast<std::byte*> (image.getData());
+
+    std::memcpy (bytes + indexOffset, index.data(), index.size() * sizeof (IndexEntry));
+
+    auto entry = index.begin();
+
+    for (const auto& [key, block] : entries)
+    {
+        std::memcpy (bytes + (entry++)->dataOffset,
+                     block.coefficients,
+                     static_cast<size_t> (key.tapCount) * sizeof (float));
+    }
+
+    FileHeader header;
+    header.magic = fileMagic;
+    header.version = formatVersion;
+    header.designId = CoefficientCache::getDesignId();
+    header.entryCount = static_cast<uint32_t> (entries.size());
+    header.indexChecksum = checksum (bytes + indexOffset, index.size() * sizeof (IndexEntry));
+    std::memcpy (bytes, &header, sizeof (header));
+
+    // Other processes may have the old file mapped; the rename leaves their pages intact.
+    file.getParentDirectory().createDirectory();
+    juce::TemporaryFile temporary (file);
+
+    if (! temporary.getFile().replaceWithData (image.getData(), image.getSize())
+        || ! temporary.overwriteTargetFileWithTemporary())
+    {
+        // On Windows the file stays mapped by this process (and maybe others), so the rename
+        // keeps failing; give up for this session rather than rewriting on every new design,
+        // and free the copies that will never be written.
+        DBG ("CoefficientDiskCache: could not write " << file.getFullPathName());
+
+        const std::lock_guard<std::mutex> guard (pendingLock);
+        writeFailed = true;
+        pendingEntries.clear();
+    }
+}
+
+void CoefficientDiskCache::openMapping()
+{
+    if (! file.existsAsFile())
+        return;
+
+    std::shared_ptr<const juce::MemoryMappedFile> mapped = std::make_shared<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readOnly);
+
+    const auto* bytes = static_cast<const std::byte*> (mapped->getData());
+    const auto size = mapped->getSize();
+
+    if (bytes == nullptr || size < sizeof (FileHeader))
+        return;
+
+    FileHeader header;
+    std::memcpy (&header, bytes, sizeof (header));
+
+    if (header.magic != fileMagic
+        || header.version != formatVersion
+        || header.designId != CoefficientCache::getDesignId()
+        || header.entryCount > maxEntries
+        || sizeof (FileHeader) + header.entryCount * sizeof (IndexEntry) > size
+        || checksum (bytes + sizeof (FileHeader), header.entryCount * sizeof (IndexEntry)) != header.indexChecksum)
+    {
+        return;
+    }
+
+    for (uint32_t entryIndex = 0; entryIndex < header.entryCount; ++entryIndex)
+    {
+        IndexEntry entry;
+        std::memcpy (&entry, bytes + sizeof (FileHeader) + entryIndex * sizeof (IndexEntry), sizeof (entry));
+
+        const auto blockBytes = static_cast<size_t> (entry.tapCount) * sizeof (float);
+
+        if (entry.tapCount <= 0
+            || entry.firstActiveTap < 0
+            || entry.firstActiveTap > (entry.tapCount - 1) / 2
+            || entry.dataOffset % dataAlignment != 0
+            || entry.dataOffset + blockBytes > size)
+        {
+            mappedEntries.clear();
+            return;
+        }
+
+        auto design = std::make_shared<CoefficientSet>();
+        design->sampleRate = fromBits<double> (entry.sampleRateBits);
+        design->tapCount = entry.tapCount;
+        design->firstActiveTap = entry.firstActiveTap;
+        design->cutoffHz = fromBits<float> (entry.cutoffBits);
+        design->mappedCoefficients = reinterpret_cast<const float*> (bytes + entry.dataOffset);
+        design->mapping = mapped;
+
+        mappedEntries.try_emplace (CoefficientKey { entry.sampleRateBits, entry.cutoffBits, entry.tapCount },
+                                   std::move (design),
+                                   entry.dataChecksum);
+    }
+
+    mapping = std::move (mapped);
+}
+
+std::shared_ptr<const CoefficientSet> CoefficientDiskCache::checkedDesign (const MappedEntry& entry)
+{
+    auto status = entry.status.load (std::memory_order_acquire);
+
+    // Racing first uses both hash the block and agree on the result.
+    if (status == BlockStatus::unchecked)
+    {
+        const auto& design = *entry.design;
+        const auto blockChecksum = checksum (design.getCoefficients(), static_cast<size_t> (design.tapCount) * sizeof (float));
+
+        status = blockChecksum == entry.dataChecksum ? BlockStatus::valid : BlockStatus::corrupt;
+        entry.status.store (status, std::memory_order_release);
+    }
+
+    return status == BlockStatus::valid ? entry.design : nullptr;
+}
+
+uint64_t CoefficientDiskCache::checksum (const void* data, size_t numBytes) noexcept
+{
+    // 64-bit FNV-1a.
+    const auto* bytes = static_cast<const std::byte*> (data);
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (size_t index = 0; index < numBytes; ++index)
+    {
+        hash ^= static_cast<uint64_t> (bytes[index]);
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+} // namespace multichainer::dsp
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "CoefficientCache.h"
+#include "core/BackgroundWorkerPool.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace multichainer::dsp
+{
+// Persists designs across sessions in one flat file, memory-mapped read-only when the cache
+// is created, so warm starts map instead of design and every process on the machine shares
+// the same clean pages. The file holds a header (magic, format version, design id, index
+// checksum), a sorted index with a checksum per entry and 64-byte-aligned coefficient blocks
+// in native byte order. Opening reads only the header and index; each coefficient block is
+// checked on first use, so untouched blocks are never paged in. A file whose header, design
+// id or index checksum does not match is ignored and rewritten; a block that fails its check
+// is designed again and dropped from the next write.
+//
+// New designs are copied into memory (key and coefficients only, so the live designs can be
+// released) and written back by a low-priority pool task, and once more on destruction.
+// Writes go through a temporary file and an atomic rename, so readers in other processes
+// never see a partial file. If a write fails (on Windows the mapping held by this process
+// blocks the rename), the pending copies are dropped and write-back stops for the session.
+class CoefficientDiskCache
+{
+public:
+    explicit CoefficientDiskCache (juce::File fileToUse);
+    ~CoefficientDiskCache();
+
+    static juce::File getDefaultFile();
+
+    std::shared_ptr<const CoefficientSet> find (const CoefficientKey& key) const;
+    void add (const CoefficientKey& key, std::shared_ptr<const CoefficientSet> design);
+
+    // Writes the mapped and pending designs to disk if anything new was added.
+    void flush();
+
+    int getNumMappedDesigns() const noexcept { return static_cast<int> (mappedEntries.size()); }
+
+private:
+    static constexpr uint32_t fileMagic = 0x4643434d; // 'MCCF'
+    static constexpr uint32_t formatVersion = 2;
+    static constexpr size_t maxEntries = 2048;
+    static constexpr size_t dataAlignment = 64;
+
+    struct FileHeader
+    {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t designId = 0;
+        uint32_t entryCount = 0;
+        uint64_t indexChecksum = 0;
+        uint64_t reserved = 0;
+    };
+
+    struct IndexEntry
+    {
+        uint64_t sampleRateBits = 0;
+        uint32_t cutoffBits = 0;
+        int32_t tapCount = 0;
+        int32_t firstActiveTap = 0;
+        uint32_t reserved = 0;
+        uint64_t dataOffset = 0;
+        uint64_t dataChecksum = 0;
+    };
+
+    enum class BlockStatus
+    {
+        unchecked,
+        valid,
+        corrupt
+    };
+
+    struct MappedEntry
+    {
+        MappedEntry (std::shared_ptr<const CoefficientSet> designIn, uint64_t checksumIn)
+            : design (std::move (designIn)), dataChecksum (checksumIn) {}
+
+        std::shared_ptr<const CoefficientSet> design;
+        uint64_t dataChecksum = 0;
+        mutable std::atomic<BlockStatus> status { BlockStatus::unchecked };
+    };
+
+    // A design waiting to be written, kept as plain data rather than a shared CoefficientSet.
+    struct PendingEntry
+    {
+        double sampleRate = 0.0;
+        float cutoffHz = 0.0f;
+        int firstActiveTap = 0;
+        std::vector<float> coefficients;
+    };
+
+    class FlushTask final : public core::BackgroundWorkerPool::Task
+    {
+    public:
+        explicit FlushTask (CoefficientDiskCache& ownerIn);
+        void run() override { owner.flush(); }
+
+    private:
+        CoefficientDiskCache& owner;
+    };
+
+    void openMapping();
+    // The entry's design once its block has passed the checksum, otherwise nullptr.
+    static std::shared_ptr<const CoefficientSet> checkedDesign (const MappedEntry& entry);
+    static uint64_t checksum (const void* data, size_t numBytes) noexcept;
+
+    const juce::File file;
+    core::BackgroundWorkerPool& pool;
+    FlushTask flushTask;
+
+    std::shared_ptr<const juce::MemoryMappedFile> mapping;
+    std::map<CoefficientKey, MappedEntry> mappedEntries;
+
+    mutable std::mutex pendingLock;
+    std::map<CoefficientKey, PendingEntry> pendingEntries;
+    bool hasUnwrittenDesigns = false;
+    bool writeFailed = false;
+
+    std::mutex flushLock;
+
+    JUCE_DECLARE_NON_COPYABLE (CoefficientDiskCache)
+};
+} // namespace multichainer::dsp
@@ -0,0 +1,313 @@
+#include "EnvelopeBank.h"
+
+#include <climits>
+#include <cmath>
+
+namespace multichainer::dsp
+{
+void EnvelopeBank::prepare (double sampleRateToUse)
+{
+    sampleRate = juce::jmax (1.0, sampleRateToUse);
+
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        setParameters (lane, {});
+        setVoiceMode (lane, VoiceMode::monoRetrigger);
+    }
+
+    reset();
+}
+
+void EnvelopeBank::reset()
+{
+    laneState.stage.fill (idle);
+    laneState.position.fill (0);
+    laneState.attackStart.fill (0.0f);
+    laneState.releaseStart.fill (1.0f);
+    laneState.targetEnvelope.fill (0.0f);
+    laneState.smoothedEnvelope.fill (0.0f);
+}
+
+void EnvelopeBank::setParameters (size_t lane, const EnvelopeParams& parameters)
+{
+    if (lane >= numLanes)
+        return;
+
+    const auto timing = EnvelopeTiming::fromParameters (parameters, sampleRate);
+    auto& lanes = laneParameters;
+
+    lanes.depthRange[lane] = 1.0f - timing.depthGain;
+
+    for (auto voiceLane = lane; voiceLane < numVoiceLanes; voiceLane += numLanes)
+    {
+        lanes.delaySamples[voiceLane] = timing.delaySamples;
+        lanes.attackSamples[voiceLane] = timing.attackSamples;
+        lanes.holdSamples[voiceLane] = timing.holdSamples;
+        lanes.releaseSamples[voiceLane] = timing.releaseSamples;
+        lanes.attackDivisor[voiceLane] = static_cast<float> (juce::jmax (1, timing.attackSamples - 1));
+        lanes.releaseDivisor[voiceLane] = static_cast<float> (juce::jmax (1, timing.releaseSamples - 1));
+        lanes.curveShape[voiceLane] = timing.curveShape;
+        lanes.smoothingStep[voiceLane] = 1.0f - timing.smoothingCoefficient;
+
+        // Stages of length <= 1 (attack, release) or 0 (hold) are passed through on entry, as in
+        // EnvelopeFollower::enterAttack/enterHold/enterRelease.
+        lanes.stageAfterAttack[voiceLane] = timing.holdSamples > 0 ? hold : (timing.releaseSamples > 1 ? release : idle);
+        lanes.stageAfterDelay[voiceLane] = timing.attackSamples > 1 ? attack : lanes.stageAfterAttack[voiceLane];
+        lanes.stageAfterHold[voiceLane] = timing.releaseSamples > 1 ? release : idle;
+        lanes.attackEndReleases[voiceLane] = timing.holdSamples <= 0 ? 1 : 0;
+        lanes.delayEndReleases[voiceLane] = timing.attackSamples <= 1 && timing.holdSamples <= 0 ? 1 : 0;
+    }
+}
+
+void EnvelopeBank::setVoiceMode (size_t lane, VoiceMode newMode) noexcept
+{
+    if (lane >= numLanes)
+        return;
+
+    laneParameters.voiceMode[lane] = newMode;
+    laneParameters.sumsVoices[lane] = newMode == VoiceMode::polySum ? 1 : 0;
+}
+
+bool EnvelopeBank::isIdle (size_t lane) const noexcept
+{
+    if (lane >= numLanes)
+        return false;
+
+    for (auto voiceLane = lane; voiceLane < numVoiceLanes; voiceLane += numLanes)
+    {
+        if (laneState.stage[voiceLane] != idle || laneState.smoothedEnvelope[voiceLane] != 0.0f)
+            return false;
+    }
+
+    return true;
+}
+
+void EnvelopeBank::process (const std::array<TriggerList, numLanes>& triggers,
+                            const std::array<float*, numLanes>& gains,
+                            int numSamples) noexcept
+{
+    const auto lanes = laneParameters;
+    auto state = laneState;
+
+    // Rows past the highest busy voice are idle at exactly zero and would stay so, so they
+    // are skipped until a trigger claims them.
+    auto activeVoices = countBusyVoices (state);
+
+    Lanes<int> nextTrigger {};
+    auto earliestTrigger = INT_MAX;
+
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        if (triggers[lane].count > 0)
+            earliestTrigger = juce::jmin (earliestTrigger, triggers[lane].samples[0]);
+    }
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        if (sample == earliestTrigger)
+        {
+            activeVoices = applyTriggers (lanes, state, triggers, nextTrigger, sample, activeVoices);
+            earliestTrigger = INT_MAX;
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                // Offsets behind the current sample never fire, as in the scalar ducker loop.
+                if (nextTrigger[lane] < triggers[lane].count && triggers[lane].samples[nextTrigger[lane]] > sample)
+                    earliestTrigger = juce::jmin (earliestTrigger, triggers[lane].samples[nextTrigger[lane]]);
+            }
+        }
+
+        const auto activeLanes = activeVoices * numLanes;
+
+        alignas (32) VoiceLanes<float> shapeBase;
+        alignas (32) VoiceLanes<float> shaped {};
+        std::array<bool, numVoices> rowShaping {};
+
+        for (size_t voiceLane = 0; voiceLane < activeLanes; ++voiceLane)
+        {
+            const auto isAttack = state.stage[voiceLane] == attack;
+            const auto divisor = isAttack ? lanes.attackDivisor[voiceLane] : lanes.releaseDivisor[voiceLane];
+            const auto progress = juce::jlimit (0.0f, 1.0f, static_cast<float> (state.position[voiceLane]) / divisor);
+
+            shapeBase[voiceLane] = isAttack ? progress : 1.0f - progress;
+            rowShaping[voiceLane / numLanes] |= isAttack | (state.stage[voiceLane] == release);
+        }
+
+        for (size_t voice = 0; voice < activeVoices; ++voice)
+        {
+            if (! rowShaping[voice])
+                continue;
+
+            for (auto voiceLane = voice * numLanes; voiceLane < (voice + 1) * numLanes; ++voiceLane)
+                shaped[voiceLane] = std::pow (shapeBase[voiceLane], lanes.curveShape[voiceLane]);
+        }
+
+        for (size_t voiceLane = 0; voiceLane < activeLanes; ++voiceLane)
+        {
+            const auto current = state.stage[voiceLane];
+            const auto isDelay = current == delay;
+            const auto isAttack = current == attack;
+            const auto isHold = current == hold;
+            const auto isRelease = current == release;
+
+            const auto attackValue = juce::jmap (shaped[voiceLane], state.attackStart[voiceLane], 1.0f);
+            const auto releaseValue = state.releaseStart[voiceLane] * shaped[voiceLane];
+            const auto value = isDelay ? state.attackStart[voiceLane]
+                             : isAttack ? attackValue
+                             : isHold ? 1.0f
+                             : isRelease ? releaseValue
+                             : 0.0f;
+
+            const auto isRunning = current != idle;
+            const auto advanced = state.position[voiceLane] + (isRunning ? 1 : 0);
+            const auto length = isDelay ? lanes.delaySamples[voiceLane]
+                              : isAttack ? lanes.attackSamples[voiceLane]
+                              : isHold ? lanes.holdSamples[voiceLane]
+                              : lanes.releaseSamples[voiceLane];
+            const auto finished = isRunning & (advanced >= length);
+
+            const auto nextStage = isDelay ? lanes.stageAfterDelay[voiceLane]
+                                 : isAttack ? lanes.stageAfterAttack[voiceLane]
+                                 : isHold ? lanes.stageAfterHold[voiceLane]
+                                 : static_cast<int32_t> (idle);
+
+            // Entering release latches the level it starts from: 1 at the end of attack,
+            // otherwise the previous sample's target.
+            const auto entersRelease = finished & ((isDelay & (lanes.delayEndReleases[voiceLane] != 0))
+                                                   | (isAttack & (lanes.attackEndReleases[voiceLane] != 0))
+                                                   | isHold);
+            const auto releaseFrom = isAttack ? 1.0f : juce::jlimit (0.0f, 1.0f, state.targetEnvelope[voiceLane]);
+
+            state.releaseStart[voiceLane] = entersRelease ? releaseFrom : state.releaseStart[voiceLane];
+            state.stage[voiceLane] = finished ? nextStage : current;
+            state.position[voiceLane] = finished ? 0 : advanced;
+
+            state.targetEnvelope[voiceLane] = value;
+            state.smoothedEnvelope[voiceLane] += (state.targetEnvelope[voiceLane] - state.smoothedEnvelope[voiceLane]) * lanes.smoothingStep[voiceLane];
+
+            const auto settles = (state.stage[voiceLane] == idle) & (state.smoothedEnvelope[voiceLane] <= EnvelopeTiming::settleThreshold);
+            state.smoothedEnvelope[voiceLane] = settles ? 0.0f : state.smoothedEnvelope[voiceLane];
+        }
+
+        // Unused voices hold exactly zero, so a mono band's maximum is its voice 0 itself.
+        alignas (16) Lanes<float> maximum;
+        alignas (16) Lanes<float> sum;
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            maximum[lane] = state.smoothedEnvelope[lane];
+            sum[lane] = state.smoothedEnvelope[lane];
+        }
+
+        for (auto voiceLane = numLanes; voiceLane < activeLanes; ++voiceLane)
+        {
+            const auto lane = voiceLane % numLanes;
+            maximum[lane] = juce::jmax (maximum[lane], state.smoothedEnvelope[voiceLane]);
+            sum[lane] += state.smoothedEnvelope[voiceLane];
+        }
+
+        alignas (16) Lanes<float> laneGains;
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            const auto combined = lanes.sumsVoices[lane] != 0 ? juce::jmin (1.0f, sum[lane]) : maximum[lane];
+            laneGains[lane] = juce::jlimit (0.0f, 1.0f, 1.0f - (combined * lanes.depthRange[lane]));
+        }
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            gains[lane][sample] = laneGains[lane];
+    }
+
+    laneState = state;
+}
+
+bool EnvelopeBank::isSettled (const LaneState& state, size_t voiceLane) noexcept
+{
+    // The target must be zero too: a skipped row keeps it, and a later trigger may latch it.
+    return state.stage[voiceLane] == idle
+        && state.smoothedEnvelope[voiceLane] == 0.0f
+        && state.targetEnvelope[voiceLane] == 0.0f;
+}
+
+size_t EnvelopeBank::countBusyVoices (const LaneState& state) noexcept
+{
+    for (auto voiceLane = numVoiceLanes; voiceLane > numLanes; --voiceLane)
+    {
+        if (! isSettled (state, voiceLane - 1))
+            return (voiceLane - 1) / numLanes + 1;
+    }
+
+    return 1;
+}
+
+size_t EnvelopeBank::applyTriggers (const LaneParameters& lanes,
+                                    LaneState& state,
+                                    const std::array<TriggerList, numLanes>& triggers,
+                                    Lanes<int>& nextTrigger,
+                                    int sample,
+                                    size_t activeVoices) noexcept
+{
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        auto triggersNow = 0;
+
+        while (nextTrigger[lane] < triggers[lane].count && triggers[lane].samples[nextTrigger[lane]] == sample)
+        {
+            ++triggersNow;
+            ++nextTrigger[lane];
+        }
+
+        if (triggersNow == 0)
+            continue;
+
+        if (lanes.voiceMode[lane] == VoiceMode::monoRetrigger)
+        {
+            triggerVoice (lanes, state, lane);
+            continue;
+        }
+
+        for (int trigger = 0; trigger < juce::jmin (triggersNow, static_cast<int> (numVoices)); ++trigger)
+        {
+            const auto voiceLane = pickVoice (state, lane);
+            triggerVoice (lanes, state, voiceLane);
+            activeVoices = juce::jmax (activeVoices, voiceLane / numLanes + 1);
+        }
+    }
+
+    return activeVoices;
+}
+
+void EnvelopeBank::triggerVoice (const LaneParameters& lanes, LaneState& state, size_t voiceLane) noexcept
+{
+    // EnvelopeFollower::noteTriggered()
+    state.attackStart[voiceLane] = state.smoothedEnvelope[voiceLane];
+    state.position[voiceLane] = 0;
+
+    if (lanes.delaySamples[voiceLane] > 0)
+    {
+        state.stage[voiceLane] = delay;
+        return;
+    }
+
+    state.stage[voiceLane] = lanes.stageAfterDelay[voiceLane];
+
+    if (lanes.delayEndReleases[voiceLane] != 0)
+        state.releaseStart[voiceLane] = juce::jlimit (0.0f, 1.0f, state.targetEnvelope[voiceLane]);
+}
+
+size_t EnvelopeBank::pickVoice (const LaneState& state, size_t lane) noexcept
+{
+    auto quietest = lane;
+
+    for (auto voiceLane = lane; voiceLane < numVoiceLanes; voiceLane += numLanes)
+    {
+        if (state.stage[voiceLane] == idle && state.smoothedEnvelope[voiceLane] == 0.0f)
+            return voiceLane;
+
+        if (state.smoothedEnvelope[voiceLane] < state.smoothedEnvelope[quietest])
+            quietest = voiceLane;
+    }
+
+    return quietest;
+}
+} // namespace multichainer::dsp
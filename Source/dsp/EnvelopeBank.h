@@ -0,0 +1,131 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "EnvelopeFollower.h"
+
+namespace multichainer::dsp
+{
+// Envelopes for several bands, each with a preallocated pool of voices, stored
+// structure-of-arrays with one lane per band and voice (lane = voice * numLanes + band), so
+// each sample advances every band in one pass of fixed-width lane loops that compilers turn
+// into SIMD selects. Stage changes are computed with selects rather than a switch per lane.
+// Triggers and the curve's pow() (only for voice rows with a lane attacking or releasing)
+// are the only per-sample branches.
+//
+// Only voice rows up to the highest busy voice are advanced; the rest hold exactly zero. In
+// mono mode every trigger restarts the band's voice 0, so all-mono bands cost one row of
+// numLanes lanes and match EnvelopeFollower bit for bit. Poly voices are combined per band
+// by their maximum or sum, so overlapping ducks layer instead of collapsing into one
+// restarted shape.
+class EnvelopeBank
+{
+public:
+    static constexpr size_t numLanes = 4;
+    static constexpr size_t numVoices = 8;
+
+    enum class VoiceMode
+    {
+        monoRetrigger, // one voice, restarted from its current level
+        polyMax,       // a voice per trigger, deepest duck wins
+        polySum        // a voice per trigger, ducks add up to the full depth
+    };
+
+    // Sorted sample offsets of one lane's note-ons within the block.
+    struct TriggerList
+    {
+        const int* samples = nullptr;
+        int count = 0;
+    };
+
+    void prepare (double sampleRateToUse);
+    void reset();
+
+    void setParameters (size_t lane, const EnvelopeParams& parameters);
+    void setVoiceMode (size_t lane, VoiceMode newMode) noexcept;
+
+    // Writes numSamples gains per lane to gains[lane].
+    void process (const std::array<TriggerList, numLanes>& triggers,
+                  const std::array<float*, numLanes>& gains,
+                  int numSamples) noexcept;
+
+    // True once every voice of the lane is idle and decayed to exactly zero
+    // (see EnvelopeFollower::isIdle).
+    bool isIdle (size_t lane) const noexcept;
+
+private:
+    static constexpr size_t numVoiceLanes = numLanes * numVoices;
+
+    template <typename Type>
+    using Lanes = std::array<Type, numLanes>;
+
+    template <typename Type>
+    using VoiceLanes = std::array<Type, numVoiceLanes>;
+
+    enum Stage : int32_t
+    {
+        idle,
+        delay,
+        attack,
+        hold,
+        release
+    };
+
+    // Replicated across every voice of a band, so the per-sample loops need no gathers.
+    struct LaneParameters
+    {
+        alignas (32) VoiceLanes<int32_t> delaySamples {};
+        alignas (32) VoiceLanes<int32_t> attackSamples {};
+        alignas (32) VoiceLanes<int32_t> holdSamples {};
+        alignas (32) VoiceLanes<int32_t> releaseSamples {};
+        alignas (32) VoiceLanes<float> attackDivisor {};
+        alignas (32) VoiceLanes<float> releaseDivisor {};
+        alignas (32) VoiceLanes<float> curveShape {};
+        alignas (32) VoiceLanes<float> smoothingStep {}; // 1 - smoothing coefficient
+
+        // Stage each transition lands in once zero-length stages are skipped, and whether
+        // that skip passes through the start of release (which latches its start level).
+        alignas (32) VoiceLanes<int32_t> stageAfterDelay {};
+        alignas (32) VoiceLanes<int32_t> stageAfterAttack {};
+        alignas (32) VoiceLanes<int32_t> stageAfterHold {};
+        alignas (32) VoiceLanes<int32_t> delayEndReleases {};
+        alignas (32) VoiceLanes<int32_t> attackEndReleases {};
+
+        // Per band.
+        alignas (16) Lanes<float> depthRange {};    // 1 - depth gain
+        alignas (16) Lanes<int32_t> sumsVoices {};  // polySum rather than the maximum
+        Lanes<VoiceMode> voiceMode {};
+    };
+
+    struct LaneState
+    {
+        alignas (32) VoiceLanes<int32_t> stage {};
+        alignas (32) VoiceLanes<int32_t> position {};
+        alignas (32) VoiceLanes<float> attackStart {};
+        alignas (32) VoiceLanes<float> releaseStart {};
+        alignas (32) VoiceLanes<float> targetEnvelope {};
+        alignas (32) VoiceLanes<float> smoothedEnvelope {};
+    };
+
+    static bool isSettled (const LaneState& state, size_t voiceLane) noexcept;
+    static size_t countBusyVoices (const LaneState& state) noexcept;
+
+    // Starts the band's voices for the triggers at this sample and returns the voice rows in use.
+    static size_t applyTriggers (const LaneParameters& parameters,
+                                 LaneState& state,
+                                 const std::array<TriggerList, numLanes>& triggers,
+                                 Lanes<int>& nextTrigger,
+                                 int sample,
+                                 size_t activeVoices) noexcept;
+    static void triggerVoice (const LaneParameters& parameters, LaneState& state, size_t voiceLane) noexcept;
+    // A free voice of the band if there is one, otherwise the quietest, which is the least
+    // audible to cut short.
+    static size_t pickVoice (const LaneState& state, size_t lane) noexcept;
+
+    double sampleRate = 44100.0;
+
+    // process() works on local copies, so stores to the gain outputs cannot alias them.
+    LaneParameters laneParameters;
+    LaneState laneState;
+};
+} // namespace multichainer::dsp
@@ -11,6 +11,28 @@ constexpr float maxCurveShape = 10.0f;
 constexpr float maxSmoothing = 0.995f;
 } // namespace
 
+EnvelopeTiming EnvelopeTiming::fromParameters (const EnvelopeParams& parameters, double sampleRate)
+{
+    const auto depthDb = juce::jlimit (0.0f, 60.0f, parameters.depthDb);
+    const auto delayMs = juce::jlimit (0.0f, 200.0f, parameters.delayMs);
+    const auto attackMs = juce::jlimit (0.0f, 2000.0f, parameters.attackMs);
+    const auto holdMs = juce::jlimit (0.0f, 2000.0f, parameters.holdMs);
+    const auto releaseMs = juce::jlimit (1.0f, 5000.0f, parameters.releaseMs);
+    const auto smoothing = juce::jlimit (0.0f, 1.0f, parameters.smoothing);
+    const auto rate = static_cast<float> (sampleRate);
+
+    EnvelopeTiming timing;
+    timing.delaySamples = juce::roundToInt (delayMs * 0.001f * rate);
+    timing.attackSamples = juce::jmax (1, juce::roundToInt (attackMs * 0.001f * rate));
+    timing.holdSamples = juce::jmax (0, juce::roundToInt (holdMs * 0.001f * rate));
+    timing.releaseSamples = juce::jmax (1, juce::roundToInt (releaseMs * 0.001f * rate));
+
+    timing.curveShape = juce::jlimit (minCurveShape, maxCurveShape, parameters.curveShape);
+    timing.depthGain = juce::Decibels::decibelsToGain (-depthDb);
+    timing.smoothingCoefficient = juce::jlimit (0.0f, maxSmoothing, smoothing);
+    return timing;
+}
+
 void EnvelopeFollower::prepare (double sampleRateToUse)
 {
     sampleRate = juce::jmax (1.0, sampleRateToUse);
@@ -29,23 +51,7 @@ void EnvelopeFollower::reset()
 
 void EnvelopeFollower::setParameters (const EnvelopeParams& newParameters)
 {
-    parameters = newParameters;
-
-    parameters.depthDb = juce::jlimit (0.0f, 60.0f, parameters.depthDb);
-    parameters.delayMs = juce::jlimit (0.0f, 200.0f, parameters.delayMs);
-    parameters.attackMs = juce::jlimit (0.0f, 2000.0f, parameters.attackMs);
-    parameters.holdMs = juce::jlimit (0.0f, 2000.0f, parameters.holdMs);
-    parameters.releaseMs = juce::jlimit (1.0f, 5000.0f, parameters.releaseMs);
-    parameters.curveShape = clampCurve (parameters.curveShape);
-    parameters.smoothing = juce::jlimit (0.0f, 1.0f, parameters.smoothing);
-
-    delaySamples = juce::roundToInt (parameters.delayMs * 0.001f * static_cast<float> (sampleRate));
-    attackSamples = juce::jmax (1, juce::roundToInt (parameters.attackMs * 0.001f * static_cast<float> (sampleRate)));
-    holdSamples = juce::jmax (0, juce::roundToInt (parameters.holdMs * 0.001f * static_cast<float> (sampleRate)));
-    releaseSamples = juce::jmax (1, juce::roundToInt (parameters.releaseMs * 0.001f * static_cast<float> (sampleRate)));
-
-    depthGain = juce::Decibels::decibelsToGain (-parameters.depthDb);
-    smoothingCoefficient = juce::jlimit (0.0f, maxSmoothing, parameters.smoothing);
+    timing = EnvelopeTiming::fromParameters (newParameters, sampleRate);
 }
 
 void EnvelopeFollower::noteTriggered()
@@ -53,7 +59,7 @@ void EnvelopeFollower::noteTriggered()
     attackStartEnvelope = smoothedEnvelope;
     stagePosition = 0;
 
-    if (delaySamples > 0)
+    if (timing.delaySamples > 0)
     {
         stage = Stage::delay;
         return;
@@ -68,9 +74,12 @@ float EnvelopeFollower::processSample (bool triggerNow)
         noteTriggered();
 
     targetEnvelope = calculateTargetEnvelope();
-    smoothedEnvelope += (targetEnvelope - smoothedEnvelope) * (1.0f - smoothingCoefficient);
+    smoothedEnvelope += (targetEnvelope - smoothedEnvelope) * (1.0f - timing.smoothingCoefficient);
+
+    if (stage == Stage::idle && smoothedEnvelope <= EnvelopeTiming::settleThreshold)
+        smoothedEnvelope = 0.0f;
 
-    const auto gain = 1.0f - (smoothedEnvelope * (1.0f - depthGain));
+    const auto gain = 1.0f - (smoothedEnvelope * (1.0f - timing.depthGain));
     return juce::jlimit (0.0f, 1.0f, gain);
 }
 
@@ -79,7 +88,7 @@ void EnvelopeFollower::enterAttack()
     stage = Stage::attack;
     stagePosition = 0;
 
-    if (attackSamples <= 1)
+    if (timing.attackSamples <= 1)
         enterHold();
 }
 
@@ -88,7 +97,7 @@ void EnvelopeFollower::enterHold()
     stage = Stage::hold;
     stagePosition = 0;
 
-    if (holdSamples <= 0)
+    if (timing.holdSamples <= 0)
         enterRelease();
 }
 
@@ -98,7 +107,7 @@ void EnvelopeFollower::enterRelease()
     stagePosition = 0;
     releaseStartEnvelope = juce::jlimit (0.0f, 1.0f, targetEnvelope);
 
-    if (releaseSamples <= 1)
+    if (timing.releaseSamples <= 1)
     {
         stage = Stage::idle;
         targetEnvelope = 0.0f;
@@ -117,7 +126,7 @@ float EnvelopeFollower::calculateTargetEnvelope()
             const auto value = attackStartEnvelope;
             ++stagePosition;
 
-            if (stagePosition >= delaySamples)
+            if (stagePosition >= timing.delaySamples)
                 enterAttack();
 
             return value;
@@ -125,12 +134,12 @@ float EnvelopeFollower::calculateTargetEnvelope()
 
         case Stage::attack:
         {
-            const auto progress = static_cast<float> (stagePosition) / static_cast<float> (juce::jmax (1, attackSamples - 1));
-            const auto shaped = std::pow (juce::jlimit (0.0f, 1.0f, progress), parameters.curveShape);
+            const auto progress = static_cast<float> (stagePosition) / static_cast<float> (juce::jmax (1, timing.attackSamples - 1));
+            const auto shaped = std::pow (juce::jlimit (0.0f, 1.0f, progress), timing.curveShape);
             const auto value = juce::jmap (shaped, attackStartEnvelope, 1.0f);
 
             ++stagePosition;
-            if (stagePosition >= attackSamples)
+            if (stagePosition >= timing.attackSamples)
             {
                 targetEnvelope = 1.0f;
                 enterHold();
@@ -142,7 +151,7 @@ float EnvelopeFollower::calculateTargetEnvelope()
         case Stage::hold:
         {
             ++stagePosition;
-            if (stagePosition >= holdSamples)
+            if (stagePosition >= timing.holdSamples)
                 enterRelease();
 
             return 1.0f;
@@ -150,12 +159,12 @@ float EnvelopeFollower::calculateTargetEnvelope()
 
         case Stage::release:
         {
-            const auto progress = static_cast<float> (stagePosition) / static_cast<float> (juce::jmax (1, releaseSamples - 1));
-            const auto shaped = std::pow (1.0f - juce::jlimit (0.0f, 1.0f, progress), parameters.curveShape);
+            const auto progress = static_cast<float> (stagePosition) / static_cast<float> (juce::jmax (1, timing.releaseSamples - 1));
+            const auto shaped = std::pow (1.0f - juce::jlimit (0.0f, 1.0f, progress), timing.curveShape);
             const auto value = releaseStartEnvelope * shaped;
 
             ++stagePosition;
-            if (stagePosition >= releaseSamples)
+            if (stagePosition >= timing.releaseSamples)
             {
                 stage = Stage::idle;
                 targetEnvelope = 0.0f;
@@ -167,9 +176,4 @@ float EnvelopeFollower::calculateTargetEnvelope()
 
     return 0.0f;
 }
-
-float EnvelopeFollower::clampCurve (float shape)
-{
-    return juce::jlimit (minCurveShape, maxCurveShape, shape);
-}
 } // namespace multichainer::dsp
@@ -15,6 +15,29 @@ struct EnvelopeParams
     float smoothing = 0.2f;   // 0 - 1
 };
 
+// EnvelopeParams clamped and converted to samples. EnvelopeFollower and EnvelopeBank both
+// derive their stages from this, so they stay sample-for-sample identical.
+struct EnvelopeTiming
+{
+    int delaySamples = 0;
+    int attackSamples = 1;
+    int holdSamples = 0;
+    int releaseSamples = 1;
+
+    float curveShape = 1.0f;
+    float depthGain = 1.0f;
+    float smoothingCoefficient = 0.2f;
+
+    static EnvelopeTiming fromParameters (const EnvelopeParams& parameters, double sampleRate);
+
+    // Once no stage is running, a smoothed envelope at or below this (-120 dB) snaps to zero.
+    // The smoothing decay alone stalls at the smallest normal float when denormals are flushed,
+    // so without the snap an idle envelope would never settle exactly.
+    static constexpr float settleThreshold = 1.0e-6f;
+};
+
+// Scalar reference envelope for one band. MultibandDucker runs its bands through
+// EnvelopeBank, which must produce the same gains bit for bit.
 class EnvelopeFollower
 {
 public:
@@ -26,6 +49,10 @@ public:
 
     float processSample (bool triggerNow);
 
+    // True once no stage is running and the smoothed envelope has settled to exactly zero, so
+    // further untriggered samples change no state and leave the gain at unity.
+    bool isIdle() const noexcept { return stage == Stage::idle && smoothedEnvelope == 0.0f; }
+
 private:
     enum class Stage
     {
@@ -41,18 +68,8 @@ private:
     void enterRelease();
     float calculateTargetEnvelope();
 
-    static float clampCurve (float shape);
-
     double sampleRate = 44100.0;
-    EnvelopeParams parameters;
-
-    int delaySamples = 0;
-    int attackSamples = 1;
-    int holdSamples = 0;
-    int releaseSamples = 1;
-
-    float depthGain = 1.0f;
-    float smoothingCoefficient = 0.2f;
+    EnvelopeTiming timing;
 
     Stage stage = Stage::idle;
     int stagePosition = 0;
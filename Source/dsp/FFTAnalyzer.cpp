@@ -1,29 +1,106 @@
 #include "FFTAnalyzer.h"
 
+#include "diagnostics/TraceRecorder.h"
+
+#include <thread>
+
 namespace multichainer::dsp
 {
-FFTAnalyzer::FFTAnalyzer()
-    : frameStorage (static_cast<size_t> (queueCapacity * numBins), 0.0f)
-{
-}
+FFTAnalyzer::FFTAnalyzer() = default;
 
 void FFTAnalyzer::prepare (int /*expectedSamplesPerBlock*/)
 {
     reset();
 }
 
+void FFTAnalyzer::carveScratch (ScratchArena& arena) noexcept
+{
+    fifoSamples = arena.carveFloats (static_cast<size_t> (fftSize));
+    fftData = arena.carveFloats (static_cast<size_t> (fftSize * 2));
+    scratchFrame = arena.carveFloats (static_cast<size_t> (numBins));
+
+    if (scratchFrame != nullptr)
+        std::fill (scratchFrame, scratchFrame + numBins, -120.0f);
+
+    fifoIndex = 0;
+}
+
 void FFTAnalyzer::reset()
 {
-    std::fill (fifoSamples.begin(), fifoSamples.end(), 0.0f);
-    std::fill (fftData.begin(), fftData.end(), 0.0f);
-    std::fill (scratchFrame.begin(), scratchFrame.end(), -120.0f);
+    if (fifoSamples != nullptr)
+    {
+        std::fill (fifoSamples, fifoSamples + fftSize, 0.0f);
+        std::fill (fftData, fftData + fftSize * 2, 0.0f);
+        std::fill (scratchFrame, scratchFrame + numBins, -120.0f);
+    }
 
     fifoIndex = 0;
     frameFifo.reset();
 }
 
+size_t FFTAnalyzer::getHeapBytes() const noexcept
+{
+    const auto queueBytes = isActive() ? static_cast<size_t> (queueCapacity * numBins) * sizeof (float) : 0;
+    return static_cast<size_t> (fftSize) * sizeof (float) + queueBytes;
+}
+
+void FFTAnalyzer::addConsumer()
+{
+    const std::lock_guard<std::mutex> guard (consumerLock);
+
+    if (numConsumers.load (std::memory_order_relaxed) == 0)
+    {
+        frameStorage.assign (static_cast<size_t> (queueCapacity * numBins), -120.0f);
+        frameFifo.reset();
+    }
+
+    // Publishes the queue before the audio thread can see the subscription.
+    numConsumers.fetch_add (1, std::memory_order_seq_cst);
+}
+
+void FFTAnalyzer::removeConsumer()
+{
+    const std::lock_guard<std::mutex> guard (consumerLock);
+
+    const auto previous = numConsumers.fetch_sub (1, std::memory_order_seq_cst);
+    jassert (previous > 0);
+
+    if (previous != 1)
+        return;
+
+    // A pushBlock() that saw the last consumer may still be writing frames; every later one
+    // sees none and returns without touching the queue.
+    while (pushInProgress.load (std::memory_order_seq_cst))
+        std::this_thread::yield();
+
+    std::vector<float>().swap (frameStorage);
+    frameFifo.reset();
+}
+
 void FFTAnalyzer::pushBlock (const juce::AudioBuffer<float>& buffer, int channelsToUse)
 {
+    if (! isActive())
+    {
+        wasActive = false;
+        return;
+    }
+
+    pushInProgress.store (true, std::memory_order_seq_cst);
+
+    if (numConsumers.load (std::memory_order_seq_cst) == 0)
+    {
+        pushInProgress.store (false, std::memory_order_release);
+        wasActive = false;
+        return;
+    }
+
+    // Samples from before the analyzer went dormant would splice two moments into one frame.
+    if (! wasActive)
+    {
+        fifoIndex = 0;
+        wasActive = true;
+    }
+
     const auto channels = juce::jlimit (1, juce::jmax (1, buffer.getNumChannels()), channelsToUse);
     const auto numSamples = buffer.getNumSamples();
 
@@ -37,10 +114,15 @@ void FFTAnalyzer::pushBlock (const juce::AudioBuffer<float>& buffer, int channel
         mono /= static_cast<float> (channels);
         pushSample (mono);
     }
+
+    pushInProgress.store (false, std::memory_order_release);
 }
 
 bool FFTAnalyzer::popLatestFrame (std::vector<float>& output)
 {
+    if (! isActive())
+        return false;
+
     const auto ready = frameFifo.getNumReady();
 
     if (ready <= 0)
@@ -75,31 +157,38 @@ bool FFTAnalyzer::popLatestFrame (std::vector<float>& output)
 
 void FFTAnalyzer::pushSample (float sample)
 {
-    fifoSamples[static_cast<size_t> (fifoIndex)] = sample;
+    fifoSamples[fifoIndex] = sample;
     ++fifoIndex;
 
     if (fifoIndex == fftSize)
     {
-        computeFrame();
+        if (++framesSinceComputed >= frameInterval)
+        {
+            computeFrame();
+            framesSinceComputed = 0;
+        }
+
         fifoIndex = 0;
     }
 }
 
 void FFTAnalyzer::computeFrame()
 {
-    std::fill (fftData.begin(), fftData.end(), 0.0f);
-    std::copy (fifoSamples.begin(), fifoSamples.end(), fftData.begin());
+    MULTICHAINER_TRACE_SCOPE ("fftFrame");
+
+    std::copy (fifoSamples, fifoSamples + fftSize, fftData);
+    std::fill (fftData + fftSize, fftData + fftSize * 2, 0.0f);
 
-    window.multiplyWithWindowingTable (fftData.data(), fftSize);
-    fft.performFrequencyOnlyForwardTransform (fftData.data(), true);
+    window.multiplyWithWindowingTable (fftData, fftSize);
+    fft.performFrequencyOnlyForwardTransform (fftData, true);
 
     for (int bin = 0; bin < numBins; ++bin)
     {
-        const auto magnitude = fftData[static_cast<size_t> (bin)] / static_cast<float> (fftSize);
-        scratchFrame[static_cast<size_t> (bin)] = juce::Decibels::gainToDecibels (magnitude, -120.0f);
+        const auto magnitude = fftData[bin] / static_cast<float> (fftSize);
+        scratchFrame[bin] = juce::Decibels::gainToDecibels (magnitude, -120.0f);
     }
 
-    pushFrameToQueue (scratchFrame.data());
+    pushFrameToQueue (scratchFrame);
 }
 
 void FFTAnalyzer::pushFrameToQueue (const float* frame)
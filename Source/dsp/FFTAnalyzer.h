@@ -2,8 +2,17 @@
 
 #include <JuceHeader.h>
 
+#include "ScratchArena.h"
+
+#include <atomic>
+#include <mutex>
+
 namespace multichainer::dsp
 {
+// Spectrum analyzer for the UI. It stays dormant until a consumer (an open editor, a tool)
+// subscribes: pushBlock() then returns after one relaxed load and the frame queue is not
+// allocated. Subscriptions are reference-counted and take effect on the audio thread's next
+// block without locking it.
 class FFTAnalyzer
 {
 public:
@@ -16,11 +25,33 @@ public:
     void prepare (int expectedSamplesPerBlock);
     void reset();
 
+    // Binds the sample FIFO and FFT work buffers into the owner's arena. The frame queue read
+    // by the UI stays separately allocated so re-laying out the arena never moves it.
+    void carveScratch (ScratchArena& arena) noexcept;
+
+    // Never call from the audio thread: the first subscription allocates the frame queue and
+    // the last one waits for an in-flight pushBlock() before releasing it.
+    void addConsumer();
+    void removeConsumer();
+    bool isActive() const noexcept { return numConsumers.load (std::memory_order_relaxed) > 0; }
+
     void pushBlock (const juce::AudioBuffer<float>& buffer, int channelsToUse);
+
+    // Audio thread. Drops a block instead of analysing it; the next pushBlock() starts a
+    // fresh frame rather than splicing across the gap.
+    void skipBlock() noexcept { wasActive = false; }
+
+    // Audio thread. Computes only every interval-th frame (1 = every frame).
+    void setFrameInterval (int interval) noexcept { frameInterval = juce::jmax (1, interval); }
+
     bool popLatestFrame (std::vector<float>& output);
 
     int getNumBins() const noexcept { return numBins; }
 
+    // Heap memory outside the scratch arena: the window table and, while subscribed, the frame
+    // queue. The FFT engine's own tables are not included.
+    size_t getHeapBytes() const noexcept;
+
 private:
     static constexpr int queueCapacity = 32;
 
@@ -33,13 +64,20 @@ private:
                                                   juce::dsp::WindowingFunction<float>::hann,
                                                   true };
 
-    std::array<float, fftSize> fifoSamples {};
-    std::array<float, fftSize * 2> fftData {};
-    std::array<float, numBins> scratchFrame {};
+    float* fifoSamples = nullptr;  // fftSize
+    float* fftData = nullptr;      // fftSize * 2
+    float* scratchFrame = nullptr; // numBins
 
     int fifoIndex = 0;
+    int frameInterval = 1;
+    int framesSinceComputed = 0;
 
     juce::AbstractFifo frameFifo { queueCapacity };
-    std::vector<float> frameStorage;
+    std::vector<float> frameStorage; // allocated only while subscribed
+
+    std::atomic<int> numConsumers { 0 };
+    std::atomic<bool> pushInProgress { false };
+    bool wasActive = false; // audio thread
+    std::mutex consumerLock;
 };
 } // namespace multichainer::dsp
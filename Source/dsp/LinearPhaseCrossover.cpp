@@ -1,5 +1,8 @@
 #include "LinearPhaseCrossover.h"
 
+#include "diagnostics/TraceRecorder.h"
+
+#include <algorithm>
 #include <cmath>
 
 namespace multichainer::dsp
@@ -25,25 +28,18 @@ int makeValidTapCount (int requestedTapCount)
 LinearPhaseCrossover::LinearPhaseCrossover (int requestedTapCount)
     : tapCount (makeValidTapCount (requestedTapCount)),
       halfTapCount ((tapCount - 1) / 2),
-      designerThread (*this)
+      redesignTask (*this)
 {
-    for (auto& slot : coefficientSlots)
-    {
-        slot[0].assign (static_cast<size_t> (tapCount), 0.0f);
-        slot[1].assign (static_cast<size_t> (tapCount), 0.0f);
-    }
-
     slotFrequencies[0] = { requestedLowMidHz.load(), requestedMidHighHz.load() };
     slotFrequencies[1] = slotFrequencies[0];
 
-    designerThread.startThread (juce::Thread::Priority::low);
+    // Start the shared workers here so schedule() never constructs the pool on the audio thread.
+    core::BackgroundWorkerPool::getInstance();
 }
 
 LinearPhaseCrossover::~LinearPhaseCrossover()
 {
-    designerThread.signalThreadShouldExit();
-    redesignEvent.signal();
-    designerThread.stopThread (1000);
+    core::BackgroundWorkerPool::getInstance().cancel (redesignTask);
 }
 
 void LinearPhaseCrossover::prepare (double sampleRateToUse, int maxBlockSizeToUse, int numChannelsToUse)
@@ -54,25 +50,31 @@ void LinearPhaseCrossover::prepare (double sampleRateToUse, int maxBlockSizeToUs
     maxBlockSize = juce::jmax (1, maxBlockSizeToUse);
     numChannels = juce::jlimit (1, maxSupportedChannels, numChannelsToUse);
 
-    delayedInput.setSize (numChannels, maxBlockSize, false, false, true);
-    lowMidBuffer.setSize (numChannels, maxBlockSize, false, false, true);
-    midHighBuffer.setSize (numChannels, maxBlockSize, false, false, true);
-
-    lowBand.setSize (numChannels, maxBlockSize, false, false, true);
-    midBand.setSize (numChannels, maxBlockSize, false, false, true);
-    highBand.setSize (numChannels, maxBlockSize, false, false, true);
-
-    lowMidFilter.prepare (numChannels, tapCount);
-    midHighFilter.prepare (numChannels, tapCount);
+    const auto crossfadeSamples = juce::jmax (1, juce::roundToInt (sampleRate * crossfadeSeconds));
+    lowMidFilter.prepare (numChannels, tapCount, crossfadeSamples);
+    midHighFilter.prepare (numChannels, tapCount, crossfadeSamples);
     delayCompensator.prepare (numChannels, halfTapCount, maxBlockSize);
 
     {
-        const juce::SpinLock::ScopedLockType lock (designLock);
-
         auto [f1, f2] = sanitizeCrossovers (requestedLowMidHz.load(), requestedMidHighHz.load(), sampleRate);
 
-        designWindowedSincLowpass (coefficientSlots[0][0], f1, sampleRate);
-        designWindowedSincLowpass (coefficientSlots[0][1], f2, sampleRate);
+        auto& cache = CoefficientCache::getInstance();
+        std::array<CoefficientCache::Design, 2> designs { cache.getLowpass (sampleRate, tapCount, f1, true),
+                                                          cache.getLowpass (sampleRate, tapCount, f2, true) };
+        std::array<CoefficientCache::Design, 2> economyDesigns;
+
+        if (economyDesignsEnabled.load (std::memory_order_acquire))
+        {
+            economyDesigns = { cache.getLowpass (sampleRate, tapCount, f1, false, DesignQuality::economy),
+                               cache.getLowpass (sampleRate, tapCount, f2, false, DesignQuality::economy) };
+        }
+
+        const juce::SpinLock::ScopedLockType lock (designLock);
+
+        std::swap (coefficientSlots[0], designs);
+        coefficientSlots[1] = coefficientSlots[0];
+        std::swap (economySlots[0], economyDesigns);
+        economySlots[1] = economySlots[0];
 
         slotFrequencies[0] = { f1, f2 };
         slotFrequencies[1] = slotFrequencies[0];
@@ -80,8 +82,7 @@ void LinearPhaseCrossover::prepare (double sampleRateToUse, int maxBlockSizeToUs
         activeSlot.store (0, std::memory_order_release);
         pendingSlot.store (-1, std::memory_order_release);
 
-        lowMidFilter.setCoefficients (coefficientSlots[0][0]);
-        midHighFilter.setCoefficients (coefficientSlots[0][1]);
+        installSlot (0, economyMode && hasEconomyDesigns (0));
 
         appliedLowMidHz = f1;
         appliedMidHighHz = f2;
@@ -93,6 +94,23 @@ void LinearPhaseCrossover::prepare (double sampleRateToUse, int maxBlockSizeToUs
     isPrepared.store (true, std::memory_order_release);
 }
 
+void LinearPhaseCrossover::carveScratch (ScratchArena& arena) noexcept
+{
+    // Ordered by access within process(): filter histories, the per-block work buffers, then
+    // the delay path that is only read once per sample.
+    lowMidFilter.carveScratch (arena);
+    midHighFilter.carveScratch (arena);
+
+    arena.carveBuffer (lowMidBuffer, numChannels, maxBlockSize);
+    arena.carveBuffer (midHighBuffer, numChannels, maxBlockSize);
+    arena.carveBuffer (lowBand, numChannels, maxBlockSize);
+    arena.carveBuffer (midBand, numChannels, maxBlockSize);
+    arena.carveBuffer (highBand, numChannels, maxBlockSize);
+
+    delayCompensator.carveScratch (arena);
+    arena.carveBuffer (delayedInput, numChannels, maxBlockSize);
+}
+
 void LinearPhaseCrossover::reset()
 {
     lowMidFilter.reset();
@@ -113,14 +131,25 @@ void LinearPhaseCrossover::setTargetFrequencies (float lowMidHz, float midHighHz
     requestRedesignIfNeeded (f1, f2);
 }
 
-void LinearPhaseCrossover::process (const juce::AudioBuffer<float>& input, int numSamples)
+void LinearPhaseCrossover::setSynchronousDesign (bool shouldDesignSynchronously) noexcept
+{
+    synchronousDesign.store (shouldDesignSynchronously, std::memory_order_release);
+}
+
+void LinearPhaseCrossover::process (const juce::AudioBuffer<float>& input, int numSamples, const BandTargets& targets)
 {
+    lowOutput = targets.low != nullptr ? targets.low : &lowBand;
+    midOutput = targets.mid != nullptr ? targets.mid : &midBand;
+    highOutput = targets.high != nullptr ? targets.high : &highBand;
+
     if (! isPrepared.load (std::memory_order_acquire))
         return;
 
     jassert (numSamples <= maxBlockSize);
-
-    applyPendingDesignIfAvailable();
+    jassert (lowBand.getNumSamples() == maxBlockSize); // carveScratch() must have run
+    jassert (lowOutput->getNumChannels() >= numChannels && lowOutput->getNumSamples() >= numSamples);
+    jassert (midOutput->getNumChannels() >= numChannels && midOutput->getNumSamples() >= numSamples);
+    jassert (highOutput->getNumChannels() >= numChannels && highOutput->getNumSamples() >= numSamples);
 
     const auto channelsFromInput = input.getNumChannels();
     const auto channelsToCopy = juce::jmin (numChannels, channelsFromInput);
@@ -138,14 +167,14 @@ void LinearPhaseCrossover::process (const juce::AudioBuffer<float>& input, int n
     }
 
     delayCompensator.process (input, delayedInput, numSamples);
-    lowMidFilter.process (lowMidBuffer, lowBand, numSamples);
+    lowMidFilter.process (lowMidBuffer, *lowOutput, numSamples);
     midHighFilter.process (midHighBuffer, midHighBuffer, numSamples);
 
     for (int channel = 0; channel < numChannels; ++channel)
     {
-        auto* low = lowBand.getWritePointer (channel);
-        auto* mid = midBand.getWritePointer (channel);
-        auto* high = highBand.getWritePointer (channel);
+        auto* low = lowOutput->getWritePointer (channel);
+        auto* mid = midOutput->getWritePointer (channel);
+        auto* high = highOutput->getWritePointer (channel);
 
         const auto* delayed = delayedInput.getReadPointer (channel);
         const auto* lp2 = midHighBuffer.getReadPointer (channel);
@@ -158,6 +187,21 @@ void LinearPhaseCrossover::process (const juce::AudioBuffer<float>& input, int n
     }
 }
 
+void LinearPhaseCrossover::processBypassed (const juce::AudioBuffer<float>& input,
+                                            juce::AudioBuffer<float>& output,
+                                            int numSamples)
+{
+    if (! isPrepared.load (std::memory_order_acquire))
+        return;
+
+    jassert (numSamples <= maxBlockSize);
+
+    // Histories first: output may alias input.
+    lowMidFilter.pushHistory (input, numSamples);
+    midHighFilter.pushHistory (input, numSamples);
+    delayCompensator.process (input, output, numSamples);
+}
+
 int LinearPhaseCrossover::getLatencySamples() const noexcept
 {
     return halfTapCount;
@@ -174,11 +218,98 @@ void LinearPhaseCrossover::requestRedesignIfNeeded (float sanitizedLowMidHz, flo
     if (! (lowMidChanged || midHighChanged))
         return;
 
+    if (synchronousDesign.load (std::memory_order_acquire) && isPrepared.load (std::memory_order_acquire))
+    {
+        designPendingSlot (sanitizedLowMidHz, sanitizedMidHighHz);
+        return;
+    }
+
     redesignRequested.store (true, std::memory_order_release);
-    redesignEvent.signal();
+    core::BackgroundWorkerPool::getInstance().schedule (redesignTask);
+}
+
+void LinearPhaseCrossover::runRequestedRedesign()
+{
+    // prepare() designs from the latest request itself, so a request made while unprepared
+    // needs no follow-up here.
+    if (! isPrepared.load (std::memory_order_acquire))
+        return;
+
+    if (! redesignRequested.exchange (false, std::memory_order_acq_rel))
+        return;
+
+    const auto requestedLow = requestedLowMidHz.load (std::memory_order_acquire);
+    const auto requestedHigh = requestedMidHighHz.load (std::memory_order_acquire);
+
+    auto [f1, f2] = sanitizeCrossovers (requestedLow, requestedHigh, sampleRate);
+    designPendingSlot (f1, f2);
 }
 
-void LinearPhaseCrossover::applyPendingDesignIfAvailable()
+void LinearPhaseCrossover::designPendingSlot (float sanitizedLowMidHz, float sanitizedMidHighHz)
+{
+    MULTICHAINER_TRACE_SCOPE ("firRedesign");
+
+    // Fetch (usually a cache hit) before taking the spin lock the audio thread try-locks.
+    auto& cache = CoefficientCache::getInstance();
+    auto lowMidDesign = cache.getLowpass (sampleRate, tapCount, sanitizedLowMidHz, false);
+    auto midHighDesign = cache.getLowpass (sampleRate, tapCount, sanitizedMidHighHz, false);
+    CoefficientCache::Design economyLowMidDesign;
+    CoefficientCache::Design economyMidHighDesign;
+
+    if (economyDesignsEnabled.load (std::memory_order_acquire))
+    {
+        economyLowMidDesign = cache.getLowpass (sampleRate, tapCount, sanitizedLowMidHz, false, DesignQuality::economy);
+        economyMidHighDesign = cache.getLowpass (sampleRate, tapCount, sanitizedMidHighHz, false, DesignQuality::economy);
+    }
+
+    const juce::SpinLock::ScopedLockType lock (designLock);
+
+    // Read under the lock: the audio thread only moves activeSlot while holding it.
+    const auto writeSlot = static_cast<size_t> (1 - activeSlot.load (std::memory_order_acquire));
+
+    // Swapping keeps the previous designs alive until this function returns, so their
+    // release (and any deallocation) happens here rather than under the lock.
+    std::swap (coefficientSlots[writeSlot][0], lowMidDesign);
+    std::swap (coefficientSlots[writeSlot][1], midHighDesign);
+    std::swap (economySlots[writeSlot][0], economyLowMidDesign);
+    std::swap (economySlots[writeSlot][1], economyMidHighDesign);
+
+    slotFrequencies[writeSlot] = { sanitizedLowMidHz, sanitizedMidHighHz };
+    pendingSlot.store (static_cast<int> (writeSlot), std::memory_order_release);
+}
+
+void LinearPhaseCrossover::applyDesignImmediately (float sanitizedLowMidHz, float sanitizedMidHighHz)
+{
+    if (! isPrepared.load (std::memory_order_acquire))
+        return;
+
+    if (juce::exactlyEqual (appliedLowMidHz, sanitizedLowMidHz) && juce::exactlyEqual (appliedMidHighHz, sanitizedMidHighHz))
+        return;
+
+    designPendingSlot (sanitizedLowMidHz, sanitizedMidHighHz);
+
+    // Unlike the audio-thread path, retry while a background designer holds the lock, and
+    // do not wait for a crossfade to finish.
+    while (pendingSlot.load (std::memory_order_acquire) >= 0)
+    {
+        swapInPendingSlot();
+
+        if (pendingSlot.load (std::memory_order_acquire) >= 0)
+            juce::Thread::yield();
+    }
+}
+
+void LinearPhaseCrossover::applyPendingDesign() noexcept
+{
+    // Swapping slots would cut a running economy crossfade short with a step, so the new
+    // design waits the few milliseconds until it completes.
+    if (lowMidFilter.isCrossfading() || midHighFilter.isCrossfading())
+        return;
+
+    swapInPendingSlot();
+}
+
+void LinearPhaseCrossover::swapInPendingSlot() noexcept
 {
     if (! designLock.tryEnter())
         return;
@@ -187,8 +318,22 @@ void LinearPhaseCrossover::applyPendingDesignIfAvailable()
 
     if (slot >= 0)
     {
-        lowMidFilter.setCoefficients (coefficientSlots[static_cast<size_t> (slot)][0]);
-        midHighFilter.setCoefficients (coefficientSlots[static_cast<size_t> (slot)][1]);
+        MULTICHAINER_TRACE_INSTANT ("coefficientSwap", slot);
+
+        const auto index = static_cast<size_t> (slot);
+        const auto useEconomy = economyMode && hasEconomyDesigns (index);
+
+        // Economy designs that arrive after economy mode was switched on fade in from the
+        // same slot's standard designs.
+        if (useEconomy && ! economyInstalled)
+        {
+            installSlot (index, false);
+            installSlot (index, true, true);
+        }
+        else
+        {
+            installSlot (index, useEconomy);
+        }
 
         activeSlot.store (slot, std::memory_order_release);
         appliedLowMidHz = slotFrequencies[static_cast<size_t> (slot)].first;
@@ -198,110 +343,173 @@ void LinearPhaseCrossover::applyPendingDesignIfAvailable()
     designLock.exit();
 }
 
-std::pair<float, float> LinearPhaseCrossover::sanitizeCrossovers (float lowMidHz,
-                                                                  float midHighHz,
-                                                                  double sampleRateValue)
+void LinearPhaseCrossover::setEconomyDesignsEnabled (bool shouldDesignEconomy) noexcept
 {
-    const auto nyquistLimited = static_cast<float> (sampleRateValue * 0.49);
-    const auto upper = juce::jmax (minimumCrossoverHz + minimumCrossoverSeparationHz,
-                                   juce::jmin (maximumCrossoverHz, nyquistLimited));
-
-    auto f1 = juce::jlimit (minimumCrossoverHz,
-                            upper - minimumCrossoverSeparationHz,
-                            lowMidHz);
+    if (economyDesignsEnabled.exchange (shouldDesignEconomy, std::memory_order_acq_rel) == shouldDesignEconomy)
+        return;
 
-    auto f2 = juce::jlimit (f1 + minimumCrossoverSeparationHz,
-                            upper,
-                            midHighHz);
+    // Disabling drops the designs with the next redesign rather than forcing one.
+    if (! shouldDesignEconomy || ! isPrepared.load (std::memory_order_acquire))
+        return;
 
-    if (f2 <= f1)
-        f2 = juce::jmin (upper, f1 + minimumCrossoverSeparationHz);
+    if (synchronousDesign.load (std::memory_order_acquire))
+    {
+        auto [f1, f2] = sanitizeCrossovers (requestedLowMidHz.load (std::memory_order_acquire),
+                                            requestedMidHighHz.load (std::memory_order_acquire),
+                                            sampleRate);
+        designPendingSlot (f1, f2);
+        return;
+    }
 
-    return { f1, f2 };
+    redesignRequested.store (true, std::memory_order_release);
+    core::BackgroundWorkerPool::getInstance().schedule (redesignTask);
 }
 
-void LinearPhaseCrossover::designWindowedSincLowpass (std::vector<float>& coefficients,
-                                                      float cutoffHz,
-                                                      double sampleRateValue)
+void LinearPhaseCrossover::setEconomyMode (bool shouldUseEconomyDesigns) noexcept
 {
-    if (coefficients.empty())
+    economyMode = shouldUseEconomyDesigns;
+
+    if (! isPrepared.load (std::memory_order_acquire))
         return;
 
-    const auto taps = static_cast<int> (coefficients.size());
-    const auto m = taps - 1;
-    const auto clampedCutoff = juce::jlimit (minimumCrossoverHz,
-                                             static_cast<float> (sampleRateValue * 0.49),
-                                             cutoffHz);
+    // Designers only ever write the inactive slot, so the active one is safe to read here,
+    // and both of its qualities stay alive for the crossfade.
+    const auto slot = static_cast<size_t> (activeSlot.load (std::memory_order_acquire));
+    const auto useEconomy = economyMode && hasEconomyDesigns (slot);
+
+    if (useEconomy != economyInstalled)
+        installSlot (slot, useEconomy, true);
+}
+
+bool LinearPhaseCrossover::isEconomyMode() const noexcept
+{
+    return economyInstalled || lowMidFilter.isCrossfading() || midHighFilter.isCrossfading();
+}
 
-    const auto fc = static_cast<double> (clampedCutoff / sampleRateValue);
+bool LinearPhaseCrossover::hasEconomyDesigns (size_t slot) const noexcept
+{
+    return economySlots[slot][0] != nullptr && economySlots[slot][1] != nullptr;
+}
+
+void LinearPhaseCrossover::installSlot (size_t slot, bool useEconomy, bool crossfade) noexcept
+{
+    const auto& designs = useEconomy ? economySlots[slot] : coefficientSlots[slot];
 
-    double normalisation = 0.0;
+    lowMidFilter.setCoefficients (*designs[0], crossfade);
+    midHighFilter.setCoefficients (*designs[1], crossfade);
+    economyInstalled = useEconomy;
+}
+
+size_t LinearPhaseCrossover::getHeapBytes() const noexcept
+{
+    return lowMidFilter.getHeapBytes() + midHighFilter.getHeapBytes();
+}
+
+size_t LinearPhaseCrossover::getHeldDesignBytes() const noexcept
+{
+    std::array<const CoefficientSet*, 8> held {};
+    size_t numHeld = 0;
 
-    for (int n = 0; n < taps; ++n)
     {
-        const auto centered = static_cast<double> (n) - (static_cast<double> (m) * 0.5);
-        const auto x = 2.0 * fc * centered;
+        const juce::SpinLock::ScopedLockType lock (designLock);
 
-        double sinc = 1.0;
-        if (std::abs (x) > 1.0e-12)
-            sinc = std::sin (juce::MathConstants<double>::pi * x)
-                   / (juce::MathConstants<double>::pi * x);
+        for (const auto* slots : { &coefficientSlots, &economySlots })
+            for (const auto& slot : *slots)
+                for (const auto& design : slot)
+                    held[numHeld++] = design.get();
+    }
 
-        const auto ideal = 2.0 * fc * sinc;
+    // Both slots usually hold the same designs; count each once.
+    size_t bytes = 0;
 
-        const auto phase = (2.0 * juce::MathConstants<double>::pi * static_cast<double> (n))
-                           / static_cast<double> (m);
+    for (size_t index = 0; index < numHeld; ++index)
+    {
+        const auto* design = held[index];
+        const auto* const* earlier = held.data();
 
-        // 4-term Blackman-Harris for strong sidelobe suppression.
-        const auto window = 0.35875
-                            - (0.48829 * std::cos (phase))
-                            + (0.14128 * std::cos (2.0 * phase))
-                            - (0.01168 * std::cos (3.0 * phase));
+        if (design == nullptr || std::find (earlier, earlier + index, design) != earlier + index)
+            continue;
 
-        const auto value = ideal * window;
-        coefficients[static_cast<size_t> (n)] = static_cast<float> (value);
-        normalisation += value;
+        bytes += sizeof (CoefficientSet) + static_cast<size_t> (design->tapCount) * sizeof (float);
     }
 
-    if (normalisation == 0.0)
-        return;
+    return bytes;
+}
+
+std::pair<float, float> LinearPhaseCrossover::sanitizeCrossovers (float lowMidHz,
+                                                                  float midHighHz,
+                                                                  double sampleRateValue)
+{
+    const auto nyquistLimited = static_cast<float> (sampleRateValue * 0.49);
+    const auto upper = juce::jmax (minimumCrossoverHz + minimumCrossoverSeparationHz,
+                                   juce::jmin (maximumCrossoverHz, nyquistLimited));
 
-    const auto invNormalisation = static_cast<float> (1.0 / normalisation);
+    auto f1 = juce::jlimit (minimumCrossoverHz,
+                            upper - minimumCrossoverSeparationHz,
+                            lowMidHz);
 
-    for (auto& coefficient : coefficients)
-        coefficient *= invNormalisation;
+    auto f2 = juce::jlimit (f1 + minimumCrossoverSeparationHz,
+                            upper,
+                            midHighHz);
+
+    if (f2 <= f1)
+        f2 = juce::jmin (upper, f1 + minimumCrossoverSeparationHz);
+
+    return { f1, f2 };
 }
 
 //==============================================================================
-void LinearPhaseCrossover::FIRLowpassFilter::prepare (int numChannelsToUse, int tapCountToUse)
+void LinearPhaseCrossover::FIRLowpassFilter::prepare (int numChannelsToUse, int tapCountToUse, int crossfadeSamples)
 {
     numChannels = juce::jmax (1, numChannelsToUse);
     tapCount = juce::jmax (1, tapCountToUse);
     halfTapCount = (tapCount - 1) / 2;
+    fadeLength = juce::jmax (1, crossfadeSamples);
+    fadeFromCoefficients = nullptr;
 
-    history.setSize (numChannels, tapCount, false, false, true);
-    history.clear();
+    writeIndices.fill (0);
 
-    writeIndices.assign (static_cast<size_t> (numChannels), 0);
-    coefficients.assign (static_cast<size_t> (tapCount), 0.0f);
+    passthroughCoefficients.assign (static_cast<size_t> (tapCount), 0.0f);
+    passthroughCoefficients[static_cast<size_t> (halfTapCount)] = 1.0f;
+    coefficients = passthroughCoefficients.data();
+    firstActiveTap = halfTapCount;
+}
 
-    coefficients[static_cast<size_t> (halfTapCount)] = 1.0f;
+void LinearPhaseCrossover::FIRLowpassFilter::carveScratch (ScratchArena& arena) noexcept
+{
+    arena.carveBuffer (history, numChannels, tapCount);
 }
 
 void LinearPhaseCrossover::FIRLowpassFilter::reset()
 {
     history.clear();
-    std::fill (writeIndices.begin(), writeIndices.end(), 0);
+    writeIndices.fill (0);
 }
 
-void LinearPhaseCrossover::FIRLowpassFilter::setCoefficients (const std::vector<float>& newCoefficients)
+void LinearPhaseCrossover::FIRLowpassFilter::setCoefficients (const CoefficientSet& newCoefficients, bool crossfade)
 {
-    jassert (static_cast<int> (newCoefficients.size()) == tapCount);
+    jassert (newCoefficients.tapCount == tapCount);
 
-    if (static_cast<int> (newCoefficients.size()) != tapCount)
+    if (newCoefficients.tapCount != tapCount)
         return;
 
-    std::copy (newCoefficients.begin(), newCoefficients.end(), coefficients.begin());
+    const auto* newKernel = newCoefficients.getCoefficients();
+
+    if (crossfade && fadeFromCoefficients != nullptr && newKernel == fadeFromCoefficients)
+    {
+        // Switching back mid-fade reverses the fade from where it has got to.
+        fadePosition = fadeLength - fadePosition;
+    }
+    else
+    {
+        fadePosition = 0;
+    }
+
+    fadeFromCoefficients = crossfade ? coefficients : nullptr;
+    fadeFromFirstActiveTap = firstActiveTap;
+
+    coefficients = newKernel;
+    firstActiveTap = juce::jlimit (0, halfTapCount, newCoefficients.firstActiveTap);
 }
 
 void LinearPhaseCrossover::FIRLowpassFilter::process (const juce::AudioBuffer<float>& input,
@@ -319,17 +527,16 @@ void LinearPhaseCrossover::FIRLowpassFilter::process (const juce::AudioBuffer<fl
 
         auto writeIndex = writeIndices[static_cast<size_t> (channel)];
 
-        for (int sample = 0; sample < numSamples; ++sample)
+        const auto convolve = [&] (const float* kernel, int firstTap)
         {
-            historyData[writeIndex] = inputData[sample];
-
             auto centreIndex = writeIndex - halfTapCount;
             if (centreIndex < 0)
                 centreIndex += tapCount;
 
-            auto accumulator = coefficients[static_cast<size_t> (halfTapCount)] * historyData[centreIndex];
+            auto accumulator = kernel[halfTapCount] * historyData[centreIndex];
 
-            for (int tap = 0; tap < halfTapCount; ++tap)
+            // Taps outside the centred kernel are zero; skip them.
+            for (int tap = firstTap; tap < halfTapCount; ++tap)
             {
                 auto indexA = writeIndex - tap;
                 if (indexA < 0)
@@ -339,10 +546,29 @@ void LinearPhaseCrossover::FIRLowpassFilter::process (const juce::AudioBuffer<fl
                 if (indexB >= tapCount)
                     indexB -= tapCount;
 
-                accumulator += coefficients[static_cast<size_t> (tap)] * (historyData[indexA] + historyData[indexB]);
+                accumulator += kernel[tap] * (historyData[indexA] + historyData[indexB]);
             }
 
-            outputData[sample] = accumulator;
+            return accumulator;
+        };
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            historyData[writeIndex] = inputData[sample];
+
+            const auto current = convolve (coefficients, firstActiveTap);
+
+            if (fadeFromCoefficients != nullptr && fadePosition + sample < fadeLength)
+            {
+                // Linear fade that reaches the new kernel on its last sample.
+                const auto previous = convolve (fadeFromCoefficients, fadeFromFirstActiveTap);
+                const auto position = static_cast<float> (fadePosition + sample + 1) / static_cast<float> (fadeLength);
+                outputData[sample] = previous + (current - previous) * position;
+            }
+            else
+            {
+                outputData[sample] = current;
+            }
 
             ++writeIndex;
             if (writeIndex >= tapCount)
@@ -352,10 +578,47 @@ void LinearPhaseCrossover::FIRLowpassFilter::process (const juce::AudioBuffer<fl
         writeIndices[static_cast<size_t> (channel)] = writeIndex;
     }
 
+    if (fadeFromCoefficients != nullptr)
+    {
+        fadePosition += numSamples;
+
+        if (fadePosition >= fadeLength)
+            fadeFromCoefficients = nullptr;
+    }
+
     for (int channel = channelsToProcess; channel < output.getNumChannels(); ++channel)
         output.clear (channel, 0, numSamples);
 }
 
+void LinearPhaseCrossover::FIRLowpassFilter::pushHistory (const juce::AudioBuffer<float>& input, int numSamples)
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* inputData = channel < input.getNumChannels() ? input.getReadPointer (channel) : nullptr;
+        auto* historyData = history.getWritePointer (channel);
+
+        auto writeIndex = writeIndices[static_cast<size_t> (channel)];
+
+        for (int written = 0; written < numSamples;)
+        {
+            const auto count = juce::jmin (numSamples - written, tapCount - writeIndex);
+
+            if (inputData != nullptr)
+                juce::FloatVectorOperations::copy (historyData + writeIndex, inputData + written, count);
+            else
+                juce::FloatVectorOperations::clear (historyData + writeIndex, count);
+
+            written += count;
+            writeIndex += count;
+
+            if (writeIndex >= tapCount)
+                writeIndex = 0;
+        }
+
+        writeIndices[static_cast<size_t> (channel)] = writeIndex;
+    }
+}
+
 //==============================================================================
 void LinearPhaseCrossover::DelayCompensator::prepare (int numChannelsToUse, int delaySamplesToUse, int maxBlockSizeInSamples)
 {
@@ -364,16 +627,18 @@ void LinearPhaseCrossover::DelayCompensator::prepare (int numChannelsToUse, int
 
     bufferLength = juce::jmax (delaySamples + maxBlockSizeInSamples + 1, delaySamples + 2);
 
-    buffer.setSize (numChannels, bufferLength, false, false, true);
-    buffer.clear();
+    writeIndices.fill (0);
+}
 
-    writeIndices.assign (static_cast<size_t> (numChannels), 0);
+void LinearPhaseCrossover::DelayCompensator::carveScratch (ScratchArena& arena) noexcept
+{
+    arena.carveBuffer (buffer, numChannels, bufferLength);
 }
 
 void LinearPhaseCrossover::DelayCompensator::reset()
 {
     buffer.clear();
-    std::fill (writeIndices.begin(), writeIndices.end(), 0);
+    writeIndices.fill (0);
 }
 
 void LinearPhaseCrossover::DelayCompensator::process (const juce::AudioBuffer<float>& input,
@@ -414,42 +679,14 @@ void LinearPhaseCrossover::DelayCompensator::process (const juce::AudioBuffer<fl
 }
 
 //==============================================================================
-LinearPhaseCrossover::CoefficientDesignerThread::CoefficientDesignerThread (LinearPhaseCrossover& ownerIn)
-    : juce::Thread ("MultiChainer FIR Designer"), owner (ownerIn)
+LinearPhaseCrossover::RedesignTask::RedesignTask (LinearPhaseCrossover& ownerIn)
+    : core::BackgroundWorkerPool::Task (core::BackgroundWorkerPool::Priority::high),
+      owner (ownerIn)
 {
 }
 
-void LinearPhaseCrossover::CoefficientDesignerThread::run()
+void LinearPhaseCrossover::RedesignTask::run()
 {
-    while (! threadShouldExit())
-    {
-        owner.redesignEvent.wait (200);
-
-        if (threadShouldExit())
-            return;
-
-        if (! owner.isPrepared.load (std::memory_order_acquire))
-            continue;
-
-        if (! owner.redesignRequested.exchange (false, std::memory_order_acq_rel))
-            continue;
-
-        const auto requestedLow = owner.requestedLowMidHz.load (std::memory_order_acquire);
-        const auto requestedHigh = owner.requestedMidHighHz.load (std::memory_order_acquire);
-
-        auto [f1, f2] = sanitizeCrossovers (requestedLow, requestedHigh, owner.sampleRate);
-
-        const auto writeSlot = 1 - owner.activeSlot.load (std::memory_order_acquire);
-
-        {
-            const juce::SpinLock::ScopedLockType lock (owner.designLock);
-
-            designWindowedSincLowpass (owner.coefficientSlots[static_cast<size_t> (writeSlot)][0], f1, owner.sampleRate);
-            designWindowedSincLowpass (owner.coefficientSlots[static_cast<size_t> (writeSlot)][1], f2, owner.sampleRate);
-
-            owner.slotFrequencies[static_cast<size_t> (writeSlot)] = { f1, f2 };
-            owner.pendingSlot.store (writeSlot, std::memory_order_release);
-        }
-    }
+    owner.runRequestedRedesign();
 }
 } // namespace multichainer::dsp
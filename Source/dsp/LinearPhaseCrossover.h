@@ -2,6 +2,10 @@
 
 #include <JuceHeader.h>
 
+#include "CoefficientCache.h"
+#include "ScratchArena.h"
+#include "core/BackgroundWorkerPool.h"
+
 #include <atomic>
 
 namespace multichainer::dsp
@@ -12,6 +16,7 @@ public:
     static constexpr int numBands = 3;
     static constexpr int maxSupportedChannels = 2;
     static constexpr int defaultTapCount = 1025;
+    static constexpr double crossfadeSeconds = 0.01;
 
     explicit LinearPhaseCrossover (int tapCount = defaultTapCount);
     ~LinearPhaseCrossover();
@@ -19,18 +24,78 @@ public:
     void prepare (double sampleRateToUse, int maxBlockSizeToUse, int numChannelsToUse);
     void reset();
 
+    // Binds every audio buffer and filter history into the owner's arena; run inside
+    // ScratchArena::layout() after prepare() and before process().
+    void carveScratch (ScratchArena& arena) noexcept;
+
     void setTargetFrequencies (float lowMidHz, float midHighHz);
-    void process (const juce::AudioBuffer<float>& input, int numSamples);
+
+    // When enabled, frequency changes are designed on the calling thread and applied on the
+    // next process() call. Intended for offline/non-realtime rendering only.
+    void setSynchronousDesign (bool shouldDesignSynchronously) noexcept;
+
+    // Swaps in a finished redesign, if any, unless an economy crossfade is still running. Call
+    // once per host block before the first process() call, so a design change always lands
+    // on a block boundary.
+    void applyPendingDesign() noexcept;
+
+    // Economy designs are only made and held while enabled (i.e. while the CPU governor is on).
+    // Enabling requests them for the current crossovers on the worker pool; disabling drops
+    // them with the next redesign. Audio thread, once per block.
+    void setEconomyDesignsEnabled (bool shouldDesignEconomy) noexcept;
+
+    // Switches both filters between the standard designs and the economy designs prepared
+    // alongside them (shorter kernels at the same latency, see DesignQuality). Until the
+    // economy designs exist the standard ones stay in use. Audio thread, before process().
+    // Band sums stay exact either way; only the band slopes get shallower.
+    // The filters crossfade from the old kernels to the new ones over crossfadeSeconds,
+    // carried across process() calls, so a ducked band (and its output bus) glides rather
+    // than stepping whatever the host block size.
+    void setEconomyMode (bool shouldUseEconomyDesigns) noexcept;
+    // True while economy kernels contribute to the output, crossfades included.
+    bool isEconomyMode() const noexcept;
+
+    // Designs (or fetches) and installs the given, already sanitised pair right away. For
+    // replaying captures offline only: it may allocate and take locks.
+    void applyDesignImmediately (float sanitizedLowMidHz, float sanitizedMidHighHz);
+
+    // Caller-owned buffers a process() call writes its bands into instead of the internal
+    // ones (e.g. host output bus channels), so band outputs need no extra copy. Each target
+    // needs the prepared channel count and numSamples samples; null keeps the internal buffer.
+    struct BandTargets
+    {
+        juce::AudioBuffer<float>* low = nullptr;
+        juce::AudioBuffer<float>* mid = nullptr;
+        juce::AudioBuffer<float>* high = nullptr;
+    };
+
+    void process (const juce::AudioBuffer<float>& input, int numSamples, const BandTargets& targets = {});
+
+    // Host bypass: writes the input, delayed by the latency, to output (which may be the input
+    // buffer) and appends it to the filter histories without convolving. Leaving bypass then
+    // continues exactly as if process() had run throughout, at the cost of a few copies.
+    void processBypassed (const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output, int numSamples);
 
     int getLatencySamples() const noexcept;
 
-    juce::AudioBuffer<float>& getLowBandBuffer() noexcept { return lowBand; }
-    juce::AudioBuffer<float>& getMidBandBuffer() noexcept { return midBand; }
-    juce::AudioBuffer<float>& getHighBandBuffer() noexcept { return highBand; }
+    // Input samples of silence after which every history and the delay line hold only zeros,
+    // so skipping process() on further silence leaves the output unchanged.
+    int getTailSamples() const noexcept { return tapCount + halfTapCount; }
+
+    // The buffers the last process() call wrote, i.e. its targets or the internal ones.
+    juce::AudioBuffer<float>& getLowBandBuffer() noexcept { return *lowOutput; }
+    juce::AudioBuffer<float>& getMidBandBuffer() noexcept { return *midOutput; }
+    juce::AudioBuffer<float>& getHighBandBuffer() noexcept { return *highOutput; }
+
+    const juce::AudioBuffer<float>& getLowBand() const noexcept { return *lowOutput; }
+    const juce::AudioBuffer<float>& getMidBand() const noexcept { return *midOutput; }
+    const juce::AudioBuffer<float>& getHighBand() const noexcept { return *highOutput; }
 
-    const juce::AudioBuffer<float>& getLowBand() const noexcept { return lowBand; }
-    const juce::AudioBuffer<float>& getMidBand() const noexcept { return midBand; }
-    const juce::AudioBuffer<float>& getHighBand() const noexcept { return highBand; }
+    // Heap memory owned outside the scratch arena (the passthrough kernels), and the coefficient
+    // designs this instance holds, which CoefficientCache may share with other instances.
+    // Message thread; the second briefly takes the design lock.
+    size_t getHeapBytes() const noexcept;
+    size_t getHeldDesignBytes() const noexcept;
 
     float getAppliedLowMidHz() const noexcept { return appliedLowMidHz; }
     float getAppliedMidHighHz() const noexcept { return appliedMidHighHz; }
@@ -39,25 +104,41 @@ private:
     class FIRLowpassFilter
     {
     public:
-        void prepare (int numChannels, int tapCount);
+        void prepare (int numChannels, int tapCount, int crossfadeSamples);
+        void carveScratch (ScratchArena& arena) noexcept;
         void reset();
-        void setCoefficients (const std::vector<float>& newCoefficients);
+        // The set must stay alive until replaced; the crossover's slots own it. With crossfade,
+        // the following crossfadeSamples of output fade from the current kernel, which must
+        // also stay alive until then; a later switch without crossfade cancels the fade.
+        void setCoefficients (const CoefficientSet& newCoefficients, bool crossfade = false);
+        bool isCrossfading() const noexcept { return fadeFromCoefficients != nullptr; }
+        size_t getHeapBytes() const noexcept { return passthroughCoefficients.capacity() * sizeof (float); }
         void process (const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output, int numSamples);
+        // Advances the history as process() would, without computing any output.
+        void pushHistory (const juce::AudioBuffer<float>& input, int numSamples);
 
     private:
         int tapCount = 0;
         int halfTapCount = 0;
+        int firstActiveTap = 0;
         int numChannels = 0;
 
         juce::AudioBuffer<float> history;
-        std::vector<int> writeIndices;
-        std::vector<float> coefficients;
+        std::array<int, maxSupportedChannels> writeIndices {};
+        std::vector<float> passthroughCoefficients;
+        const float* coefficients = nullptr;
+
+        const float* fadeFromCoefficients = nullptr;
+        int fadeFromFirstActiveTap = 0;
+        int fadeLength = 1;
+        int fadePosition = 0;
     };
 
     class DelayCompensator
     {
     public:
         void prepare (int numChannels, int delaySamples, int maxBlockSizeInSamples);
+        void carveScratch (ScratchArena& arena) noexcept;
         void reset();
         void process (const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output, int numSamples);
 
@@ -67,25 +148,26 @@ private:
         int bufferLength = 0;
 
         juce::AudioBuffer<float> buffer;
-        std::vector<int> writeIndices;
+        std::array<int, maxSupportedChannels> writeIndices {};
     };
 
-    class CoefficientDesignerThread : public juce::Thread
+    // Runs on the shared BackgroundWorkerPool; repeated requests coalesce into one pass.
+    class RedesignTask final : public core::BackgroundWorkerPool::Task
     {
     public:
-        explicit CoefficientDesignerThread (LinearPhaseCrossover& ownerIn);
+        explicit RedesignTask (LinearPhaseCrossover& ownerIn);
         void run() override;
 
     private:
         LinearPhaseCrossover& owner;
     };
 
-    static void designWindowedSincLowpass (std::vector<float>& coefficients,
-                                           float cutoffHz,
-                                           double sampleRate);
-
     void requestRedesignIfNeeded (float sanitizedLowMidHz, float sanitizedMidHighHz);
-    void applyPendingDesignIfAvailable();
+    void swapInPendingSlot() noexcept;
+    bool hasEconomyDesigns (size_t slot) const noexcept;
+    void installSlot (size_t slot, bool useEconomy, bool crossfade = false) noexcept;
+    void designPendingSlot (float sanitizedLowMidHz, float sanitizedMidHighHz);
+    void runRequestedRedesign();
 
     static std::pair<float, float> sanitizeCrossovers (float lowMidHz,
                                                        float midHighHz,
@@ -111,7 +193,14 @@ private:
     juce::AudioBuffer<float> midBand;
     juce::AudioBuffer<float> highBand;
 
-    std::array<std::array<std::vector<float>, 2>, 2> coefficientSlots;
+    juce::AudioBuffer<float>* lowOutput = &lowBand;
+    juce::AudioBuffer<float>* midOutput = &midBand;
+    juce::AudioBuffer<float>* highOutput = &highBand;
+
+    // Shared designs from CoefficientCache. The audio thread only dereferences the active
+    // slot; designers replace the other one, so references are never dropped in process().
+    std::array<std::array<CoefficientCache::Design, 2>, 2> coefficientSlots;
+    std::array<std::array<CoefficientCache::Design, 2>, 2> economySlots;
     std::array<std::pair<float, float>, 2> slotFrequencies;
 
     std::atomic<float> requestedLowMidHz { 200.0f };
@@ -120,12 +209,15 @@ private:
     std::atomic<int> activeSlot { 0 };
     std::atomic<int> pendingSlot { -1 };
     std::atomic<bool> redesignRequested { false };
+    std::atomic<bool> synchronousDesign { false };
+    std::atomic<bool> economyDesignsEnabled { false };
 
     float appliedLowMidHz = 200.0f;
     float appliedMidHighHz = 2500.0f;
+    bool economyMode = false;      // audio thread
+    bool economyInstalled = false; // audio thread
 
-    juce::SpinLock designLock;
-    juce::WaitableEvent redesignEvent;
-    CoefficientDesignerThread designerThread;
+    mutable juce::SpinLock designLock;
+    RedesignTask redesignTask;
 };
 } // namespace multichainer::dsp
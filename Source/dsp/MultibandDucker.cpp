@@ -1,5 +1,7 @@
 #include "MultibandDucker.h"
 
+#include <algorithm>
+
 namespace multichainer::dsp
 {
 void MultibandDucker::prepare (double sampleRateToUse, int maxBlockSizeToUse, int numChannelsToUse)
@@ -8,21 +10,26 @@ void MultibandDucker::prepare (double sampleRateToUse, int maxBlockSizeToUse, in
     maxBlockSize = juce::jmax (1, maxBlockSizeToUse);
     numChannels = juce::jmax (1, numChannelsToUse);
 
-    for (auto& band : bands)
+    envelopes.prepare (sampleRate);
+
+    for (size_t bandIndex = 0; bandIndex < bands.size(); ++bandIndex)
     {
-        band.envelope.prepare (sampleRate);
-        band.envelope.reset();
-        band.numTriggers = 0;
+        setBandParameters (bandIndex, bands[bandIndex].parameters);
+        bands[bandIndex].numTriggers = 0;
     }
 }
 
+void MultibandDucker::carveScratch (ScratchArena& arena) noexcept
+{
+    arena.carveBuffer (gainBuffer, static_cast<int> (EnvelopeBank::numLanes), maxBlockSize);
+}
+
 void MultibandDucker::reset()
 {
+    envelopes.reset();
+
     for (auto& band : bands)
-    {
-        band.envelope.reset();
         band.numTriggers = 0;
-    }
 }
 
 void MultibandDucker::setBandParameters (size_t bandIndex, const BandParameters& parameters)
@@ -47,7 +54,8 @@ void MultibandDucker::setBandParameters (size_t bandIndex, const BandParameters&
     envelope.curveShape = parameters.curveShape;
     envelope.smoothing = parameters.smoothing;
 
-    band.envelope.setParameters (envelope);
+    envelopes.setParameters (bandIndex, envelope);
+    envelopes.setVoiceMode (bandIndex, parameters.voiceMode);
 }
 
 void MultibandDucker::clearBlockTriggers()
@@ -73,38 +81,53 @@ void MultibandDucker::pushMidiMessage (const juce::MidiMessage& message, int sam
     }
 }
 
+bool MultibandDucker::hasPendingTriggers() const noexcept
+{
+    return std::any_of (bands.begin(), bands.end(), [] (const BandState& band) { return band.numTriggers > 0; });
+}
+
+bool MultibandDucker::areAllEnvelopesIdle() const noexcept
+{
+    for (size_t bandIndex = 0; bandIndex < bands.size(); ++bandIndex)
+    {
+        if (! envelopes.isIdle (bandIndex))
+            return false;
+    }
+
+    return true;
+}
+
 void MultibandDucker::processBands (juce::AudioBuffer<float>& lowBand,
                                     juce::AudioBuffer<float>& midBand,
                                     juce::AudioBuffer<float>& highBand,
                                     int numSamples)
 {
-    processSingleBand (bands[0], lowBand, numSamples);
-    processSingleBand (bands[1], midBand, numSamples);
-    processSingleBand (bands[2], highBand, numSamples);
+    jassert (numSamples <= gainBuffer.getNumSamples()); // carveScratch() must have run
+    numSamples = juce::jmin (numSamples, gainBuffer.getNumSamples());
 
-    clearBlockTriggers();
-}
+    std::array<EnvelopeBank::TriggerList, EnvelopeBank::numLanes> triggers {};
+    std::array<float*, EnvelopeBank::numLanes> gains {};
 
-void MultibandDucker::processSingleBand (BandState& band, juce::AudioBuffer<float>& audio, int numSamples)
-{
-    const auto channelsToProcess = juce::jmin (numChannels, audio.getNumChannels());
+    for (size_t lane = 0; lane < EnvelopeBank::numLanes; ++lane)
+    {
+        if (lane < bands.size())
+            triggers[lane] = { bands[lane].triggerSamples.data(), bands[lane].numTriggers };
 
-    int triggerIndex = 0;
+        gains[lane] = gainBuffer.getWritePointer (static_cast<int> (lane));
+    }
 
-    for (int sample = 0; sample < numSamples; ++sample)
-    {
-        auto triggerNow = false;
+    envelopes.process (triggers, gains, numSamples);
 
-        while (triggerIndex < band.numTriggers && band.triggerSamples[static_cast<size_t> (triggerIndex)] == sample)
-        {
-            triggerNow = true;
-            ++triggerIndex;
-        }
+    const std::array<juce::AudioBuffer<float>*, numBands> audio { &lowBand, &midBand, &highBand };
 
-        const auto gain = band.envelope.processSample (triggerNow);
+    for (size_t bandIndex = 0; bandIndex < numBands; ++bandIndex)
+    {
+        const auto channelsToProcess = juce::jmin (numChannels, audio[bandIndex]->getNumChannels());
 
         for (int channel = 0; channel < channelsToProcess; ++channel)
-            audio.getWritePointer (channel)[sample] *= gain;
+            juce::FloatVectorOperations::multiply (audio[bandIndex]->getWritePointer (channel), gains[bandIndex], numSamples);
     }
+
+    clearBlockTriggers();
 }
 } // namespace multichainer::dsp
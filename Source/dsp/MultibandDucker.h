@@ -2,8 +2,9 @@
 
 #include <JuceHeader.h>
 
-#include "EnvelopeFollower.h"
+#include "EnvelopeBank.h"
 #include "MidiTrigger.h"
+#include "ScratchArena.h"
 
 namespace multichainer::dsp
 {
@@ -23,16 +24,25 @@ public:
         float releaseMs = 160.0f;
         float curveShape = 1.0f;
         float smoothing = 0.2f;
+
+        EnvelopeBank::VoiceMode voiceMode = EnvelopeBank::VoiceMode::monoRetrigger;
     };
 
     void prepare (double sampleRateToUse, int maxBlockSizeToUse, int numChannelsToUse);
     void reset();
 
+    // Binds the per-lane gain rows into the owner's arena; run inside ScratchArena::layout()
+    // after prepare() and before processBands().
+    void carveScratch (ScratchArena& arena) noexcept;
+
     void setBandParameters (size_t bandIndex, const BandParameters& parameters);
 
     void clearBlockTriggers();
     void pushMidiMessage (const juce::MidiMessage& message, int sampleOffset, int numSamplesInBlock);
 
+    bool hasPendingTriggers() const noexcept;
+    bool areAllEnvelopesIdle() const noexcept;
+
     void processBands (juce::AudioBuffer<float>& lowBand,
                        juce::AudioBuffer<float>& midBand,
                        juce::AudioBuffer<float>& highBand,
@@ -44,17 +54,21 @@ private:
     struct BandState
     {
         MidiTrigger trigger;
-        EnvelopeFollower envelope;
         BandParameters parameters;
         std::array<int, maxTriggersPerBlock> triggerSamples {};
         int numTriggers = 0;
     };
 
-    void processSingleBand (BandState& band, juce::AudioBuffer<float>& audio, int numSamples);
+    static_assert (numBands <= EnvelopeBank::numLanes, "each band needs an EnvelopeBank lane");
 
     double sampleRate = 44100.0;
     int maxBlockSize = 512;
     int numChannels = 2;
     std::array<BandState, numBands> bands;
+
+    // One lane per band; gainBuffer holds a block of per-sample gains for every lane, carved
+    // from the arena.
+    EnvelopeBank envelopes;
+    juce::AudioBuffer<float> gainBuffer;
 };
 } // namespace multichainer::dsp
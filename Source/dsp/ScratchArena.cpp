@@ -0,0 +1,59 @@
+#include "ScratchArena.h"
+
+namespace multichainer::dsp
+{
+void ScratchArena::layout (const std::function<void (ScratchArena&)>& carveAll)
+{
+    auto* previousBase = base;
+    base = nullptr;
+    cursor = 0;
+    carveAll (*this);
+
+    const auto requiredBytes = cursor;
+
+    if (requiredBytes > capacityBytes)
+    {
+        storage.free();
+        storage.allocate (requiredBytes + alignment, false);
+
+        const auto address = reinterpret_cast<uintptr_t> (storage.get());
+        base = storage.get() + (alignUp (address) - address);
+        capacityBytes = requiredBytes;
+    }
+    else
+    {
+        base = previousBase;
+    }
+
+    if (base != nullptr)
+        std::memset (base, 0, requiredBytes);
+
+    usedBytes = requiredBytes;
+    cursor = 0;
+    carveAll (*this);
+
+    jassert (cursor == usedBytes);
+}
+
+float* ScratchArena::carveFloats (size_t count) noexcept
+{
+    const auto offset = alignUp (cursor);
+    cursor = offset + count * sizeof (float);
+
+    return base != nullptr ? reinterpret_cast<float*> (base + offset) : nullptr;
+}
+
+void ScratchArena::carveBuffer (juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) noexcept
+{
+    std::array<float*, 8> channels {};
+    jassert (numChannels <= static_cast<int> (channels.size()));
+
+    numChannels = juce::jmin (numChannels, static_cast<int> (channels.size()));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        channels[static_cast<size_t> (channel)] = carveFloats (static_cast<size_t> (numSamples));
+
+    if (base != nullptr)
+        buffer.setDataToReferTo (channels.data(), numChannels, numSamples);
+}
+} // namespace multichainer::dsp
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace multichainer::dsp
+{
+// One 64-byte-aligned block holding an instance's audio-thread scratch memory, so buffers
+// that are touched together sit next to each other instead of in separate heap blocks.
+//
+// Components carve their views inside a layout callback, which runs twice: once to measure
+// (carve calls return nullptr and bind nothing) and once after the block is (re)allocated.
+// Only call layout() where allocation is allowed, e.g. prepareToPlay.
+class ScratchArena
+{
+public:
+    static constexpr size_t alignment = 64;
+
+    void layout (const std::function<void (ScratchArena&)>& carveAll);
+
+    // Returns nullptr during the measuring pass.
+    float* carveFloats (size_t count) noexcept;
+
+    // Points `buffer` at numChannels aligned rows of numSamples inside the arena.
+    void carveBuffer (juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) noexcept;
+
+    size_t getUsedBytes() const noexcept { return usedBytes; }
+    size_t getCapacityBytes() const noexcept { return capacityBytes; }
+
+private:
+    static size_t alignUp (size_t bytes) noexcept { return (bytes + alignment - 1) & ~(alignment - 1); }
+
+    juce::HeapBlock<std::byte> storage;
+    std::byte* base = nullptr;
+    size_t capacityBytes = 0;
+    size_t usedBytes = 0;
+    size_t cursor = 0;
+};
+} // namespace multichainer::dsp
@@ -0,0 +1,374 @@
+// Standalone DSP benchmark.
+//
+// Drives the LinearPhaseCrossover -> MultibandDucker -> mix -> FFTAnalyzer chain exactly as
+// MultiChainerAudioProcessor::processBlock does (host blocks walked in fixed tiles), sweeping one dimension at a time around a
+// baseline configuration, and prints a JSON report to stdout (or --output <file>).
+//
+//   MultiChainerBench [--seconds <n>] [--quick] [--output <file>]
+
+#include <JuceHeader.h>
+
+#include "diagnostics/TraceRecorder.h"
+#include "dsp/FFTAnalyzer.h"
+#include "dsp/LinearPhaseCrossover.h"
+#include "dsp/MultibandDucker.h"
+#include "dsp/ScratchArena.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+using multichainer::dsp::FFTAnalyzer;
+using multichainer::dsp::ScratchArena;
+using multichainer::dsp::LinearPhaseCrossover;
+using multichainer::dsp::MultibandDucker;
+
+// Matches MultiChainerAudioProcessor::processingTileSize.
+constexpr int processingTileSize = 64;
+
+enum class AutomationPattern
+{
+    none,
+    slowSweep,
+    jumps
+};
+
+juce::String toString (AutomationPattern pattern)
+{
+    switch (pattern)
+    {
+        case AutomationPattern::none:      return "none";
+        case AutomationPattern::slowSweep: return "slowSweep";
+        case AutomationPattern::jumps:     return "jumps";
+    }
+
+    return "unknown";
+}
+
+struct BenchCase
+{
+    juce::String sweep;
+    double sampleRate = 48000.0;
+    int blockSize = 256;
+    int tapCount = LinearPhaseCrossover::defaultTapCount;
+    double triggersPerSecond = 4.0;
+    AutomationPattern automation = AutomationPattern::none;
+};
+
+struct BenchResult
+{
+    double nsPerSample = 0.0;
+    double p50BlockNs = 0.0;
+    double p99BlockNs = 0.0;
+    double maxBlockNs = 0.0;
+    double realTimeFactor = 0.0;
+    int numBlocks = 0;
+};
+
+double percentile (const std::vector<double>& sorted, double fraction)
+{
+    if (sorted.empty())
+        return 0.0;
+
+    const auto index = static_cast<size_t> (juce::jlimit (0.0,
+                                                          static_cast<double> (sorted.size() - 1),
+                                                          std::ceil (fraction * static_cast<double> (sorted.size())) - 1.0));
+    return sorted[index];
+}
+
+void crossoverTargetsForBlock (AutomationPattern pattern, int blockIndex, double blockSeconds, float& lowMidHz, float& midHighHz)
+{
+    lowMidHz = 180.0f;
+    midHighHz = 2500.0f;
+
+    const auto seconds = static_cast<double> (blockIndex) * blockSeconds;
+
+    switch (pattern)
+    {
+        case AutomationPattern::none:
+            break;
+
+        case AutomationPattern::slowSweep:
+        {
+            // One full up/down sweep every four seconds.
+            const auto phase = 0.5 + 0.5 * std::sin (seconds * juce::MathConstants<double>::twoPi * 0.25);
+            lowMidHz = static_cast<float> (80.0 * std::pow (8.0, phase));
+            midHighHz = static_cast<float> (1500.0 * std::pow (4.0, phase));
+            break;
+        }
+
+        case AutomationPattern::jumps:
+        {
+            // Alternate between two settings every 50 ms.
+            const auto toggle = (static_cast<int> (seconds / 0.05) % 2) == 0;
+            lowMidHz = toggle ? 120.0f : 400.0f;
+            midHighHz = toggle ? 2000.0f : 6000.0f;
+            break;
+        }
+    }
+}
+
+BenchResult runCase (const BenchCase& benchCase, double secondsToMeasure)
+{
+    constexpr int numChannels = 2;
+    constexpr double warmUpSeconds = 0.5;
+
+    LinearPhaseCrossover crossover (benchCase.tapCount);
+    MultibandDucker ducker;
+    FFTAnalyzer analyzer;
+    ScratchArena scratchArena;
+
+    crossover.prepare (benchCase.sampleRate, processingTileSize, numChannels);
+    crossover.reset();
+    ducker.prepare (benchCase.sampleRate, processingTileSize, numChannels);
+    ducker.reset();
+    analyzer.prepare (benchCase.blockSize);
+    analyzer.reset();
+    analyzer.addConsumer(); // measure the chain as it runs with an editor open
+    scratchArena.layout ([&] (ScratchArena& arena)
+                         {
+                             crossover.carveScratch (arena);
+                             ducker.carveScratch (arena);
+                             analyzer.carveScratch (arena);
+                         });
+
+    for (size_t band = 0; band < MultibandDucker::numBands; ++band)
+    {
+        MultibandDucker::BandParameters parameters;
+        parameters.depthDb = 12.0f;
+        parameters.releaseMs = 180.0f;
+        ducker.setBandParameters (band, parameters);
+    }
+
+    juce::AudioBuffer<float> buffer (numChannels, benchCase.blockSize);
+    juce::AudioBuffer<float> tileView;
+    juce::Random random (0x4d43);
+    const auto noteOn = juce::MidiMessage::noteOn (1, 36, static_cast<juce::uint8> (100));
+
+    const auto blockSeconds = static_cast<double> (benchCase.blockSize) / benchCase.sampleRate;
+    const auto warmUpBlocks = static_cast<int> (std::ceil (warmUpSeconds / blockSeconds));
+    const auto measuredBlocks = juce::jmax (1, static_cast<int> (std::ceil (secondsToMeasure / blockSeconds)));
+    const auto samplesPerTrigger = benchCase.triggersPerSecond > 0.0 ? benchCase.sampleRate / benchCase.triggersPerSecond : 0.0;
+
+    std::vector<double> blockNs;
+    blockNs.reserve (static_cast<size_t> (measuredBlocks));
+
+    double nextTriggerSample = 0.0;
+    int64_t blockStartSample = 0;
+
+    for (int block = 0; block < warmUpBlocks + measuredBlocks; ++block)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* data = buffer.getWritePointer (channel);
+
+            for (int sample = 0; sample < benchCase.blockSize; ++sample)
+                data[sample] = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        float lowMidHz = 0.0f;
+        float midHighHz = 0.0f;
+        crossoverTargetsForBlock (benchCase.automation, block, blockSeconds, lowMidHz, midHighHz);
+        crossover.setTargetFrequencies (lowMidHz, midHighHz);
+        crossover.applyPendingDesign();
+
+        ducker.clearBlockTriggers();
+
+        for (int tileStart = 0; tileStart < benchCase.blockSize; tileStart += processingTileSize)
+        {
+            const auto tileSamples = juce::jmin (processingTileSize, benchCase.blockSize - tileStart);
+
+            if (samplesPerTrigger > 0.0)
+            {
+                const auto tileStartSample = static_cast<double> (blockStartSample + tileStart);
+
+                while (nextTriggerSample < tileStartSample + tileSamples)
+                {
+                    ducker.pushMidiMessage (noteOn,
+                                            static_cast<int> (nextTriggerSample - tileStartSample),
+                                            tileSamples);
+                    nextTriggerSample += samplesPerTrigger;
+                }
+            }
+
+            tileView.setDataToReferTo (buffer.getArrayOfWritePointers(), numChannels, tileStart, tileSamples);
+            crossover.process (tileView, tileSamples);
+
+            auto& lowBand = crossover.getLowBandBuffer();
+            auto& midBand = crossover.getMidBandBuffer();
+            auto& highBand = crossover.getHighBandBuffer();
+
+            ducker.processBands (lowBand, midBand, highBand, tileSamples);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* output = tileView.getWritePointer (channel);
+
+                const auto* low = lowBand.getReadPointer (channel);
+                const auto* mid = midBand.getReadPointer (channel);
+                const auto* high = highBand.getReadPointer (channel);
+
+                for (int sample = 0; sample < tileSamples; ++sample)
+                    output[sample] = low[sample] + mid[sample] + high[sample];
+            }
+
+            analyzer.pushBlock (tileView, numChannels);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+
+        if (block >= warmUpBlocks)
+            blockNs.push_back (static_cast<double> (std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count()));
+
+        blockStartSample += benchCase.blockSize;
+    }
+
+    BenchResult result;
+    result.numBlocks = static_cast<int> (blockNs.size());
+
+    double totalNs = 0.0;
+    for (auto ns : blockNs)
+        totalNs += ns;
+
+    std::sort (blockNs.begin(), blockNs.end());
+
+    const auto totalSamples = static_cast<double> (blockNs.size()) * static_cast<double> (benchCase.blockSize);
+    const auto audioNs = totalSamples / benchCase.sampleRate * 1.0e9;
+
+    result.nsPerSample = totalSamples > 0.0 ? totalNs / totalSamples : 0.0;
+    result.p50BlockNs = percentile (blockNs, 0.50);
+    result.p99BlockNs = percentile (blockNs, 0.99);
+    result.maxBlockNs = blockNs.empty() ? 0.0 : blockNs.back();
+    result.realTimeFactor = totalNs > 0.0 ? audioNs / totalNs : 0.0;
+
+    return result;
+}
+
+std::vector<BenchCase> buildCases (bool quick)
+{
+    const BenchCase baseline;
+    std::vector<BenchCase> cases;
+
+    const auto addCase = [&cases] (BenchCase benchCase, const juce::String& sweep)
+    {
+        benchCase.sweep = sweep;
+        cases.push_back (benchCase);
+    };
+
+    addCase (baseline, "baseline");
+
+    const std::vector<int> blockSizes = quick ? std::vector<int> { 64, 1024 }
+                                              : std::vector<int> { 32, 64, 128, 512, 1024, 2048 };
+    for (auto blockSize : blockSizes)
+    {
+        auto benchCase = baseline;
+        benchCase.blockSize = blockSize;
+        addCase (benchCase, "blockSize");
+    }
+
+    const std::vector<double> sampleRates = quick ? std::vector<double> { 96000.0 }
+                                                  : std::vector<double> { 44100.0, 88200.0, 96000.0, 192000.0 };
+    for (auto sampleRate : sampleRates)
+    {
+        auto benchCase = baseline;
+        benchCase.sampleRate = sampleRate;
+        addCase (benchCase, "sampleRate");
+    }
+
+    const std::vector<int> tapCounts = quick ? std::vector<int> { 255 }
+                                             : std::vector<int> { 255, 511, 2047, 4095 };
+    for (auto tapCount : tapCounts)
+    {
+        auto benchCase = baseline;
+        benchCase.tapCount = tapCount;
+        addCase (benchCase, "tapCount");
+    }
+
+    const std::vector<double> triggerDensities = quick ? std::vector<double> { 0.0, 64.0 }
+                                                       : std::vector<double> { 0.0, 1.0, 16.0, 64.0, 256.0 };
+    for (auto density : triggerDensities)
+    {
+        auto benchCase = baseline;
+        benchCase.triggersPerSecond = density;
+        addCase (benchCase, "triggerDensity");
+    }
+
+    for (auto pattern : { AutomationPattern::slowSweep, AutomationPattern::jumps })
+    {
+        auto benchCase = baseline;
+        benchCase.automation = pattern;
+        addCase (benchCase, "crossoverAutomation");
+    }
+
+    return cases;
+}
+
+juce::var toVar (const BenchCase& benchCase, const BenchResult& result)
+{
+    auto object = std::make_unique<juce::DynamicObject>();
+
+    object->setProperty ("sweep", benchCase.sweep);
+    object->setProperty ("sampleRate", benchCase.sampleRate);
+    object->setProperty ("blockSize", benchCase.blockSize);
+    object->setProperty ("tapCount", benchCase.tapCount);
+    object->setProperty ("triggersPerSecond", benchCase.triggersPerSecond);
+    object->setProperty ("automation", toString (benchCase.automation));
+
+    object->setProperty ("blocks", result.numBlocks);
+    object->setProperty ("nsPerSample", result.nsPerSample);
+    object->setProperty ("p50BlockNs", result.p50BlockNs);
+    object->setProperty ("p99BlockNs", result.p99BlockNs);
+    object->setProperty ("maxBlockNs", result.maxBlockNs);
+    object->setProperty ("realTimeFactor", result.realTimeFactor);
+
+    return juce::var (object.release());
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedNoDenormals noDenormals;
+    multichainer::diagnostics::TraceRecorder::initialise();
+
+    juce::ArgumentList arguments (argc, argv);
+
+    const auto quick = arguments.containsOption ("--quick");
+    const auto secondsOption = arguments.getValueForOption ("--seconds");
+    const auto secondsToMeasure = secondsOption.isNotEmpty() ? juce::jmax (0.1, secondsOption.getDoubleValue())
+                                                             : (quick ? 2.0 : 10.0);
+
+    juce::Array<juce::var> results;
+
+    for (const auto& benchCase : buildCases (quick))
+        results.add (toVar (benchCase, runCase (benchCase, secondsToMeasure)));
+
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty ("tool", "MultiChainerBench");
+    report->setProperty ("version", JUCE_STRINGIFY (MULTICHAINER_VERSION));
+    report->setProperty ("secondsPerCase", secondsToMeasure);
+    report->setProperty ("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty ("results", juce::var (results));
+
+    const auto json = juce::JSON::toString (juce::var (report.release()));
+    const auto outputPath = arguments.getValueForOption ("--output");
+
+    if (outputPath.isNotEmpty())
+    {
+        const auto outputFile = juce::File::getCurrentWorkingDirectory().getChildFile (outputPath);
+
+        if (! outputFile.replaceWithText (json))
+        {
+            std::cerr << "Could not write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    std::cout << json << std::endl;
+    return 0;
+}
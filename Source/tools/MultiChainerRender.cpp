@@ -0,0 +1,321 @@
+// Headless offline renderer.
+//
+// Runs WAV files through MultiChainerAudioProcessor (built without the editor) with MIDI
+// triggers from a Standard MIDI File, writing latency-compensated output. Files are rendered
+// in parallel, one job per file, and audio is streamed block by block so memory stays flat.
+//
+//   MultiChainerRender [--midi <file.mid>] [--state <file>] [--output-dir <dir>]
+//                      [--jobs <n>] [--block <samples>] <input.wav>...
+//
+// A <name>.mid next to <name>.wav takes precedence over --midi. --state accepts either a
+// blob saved by getStateInformation or an XML preset of the parameter tree.
+
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+struct RenderSettings
+{
+    juce::File midiFile;
+    juce::File stateFile;
+    juce::MemoryBlock state;
+    juce::File outputDirectory;
+    int blockSize = 512;
+};
+
+juce::MemoryBlock loadStateFile (const juce::File& file)
+{
+    juce::MemoryBlock state;
+
+    if (! file.loadFileAsData (state))
+        return {};
+
+    // Presets may be the bare XML parameter tree; wrap them the same way the processor does.
+    if (state.getSize() > 0 && static_cast<const char*> (state.getData())[0] == '<')
+    {
+        if (auto xml = juce::parseXML (state.toString()))
+        {
+            juce::MemoryBlock wrapped;
+            juce::AudioProcessor::copyXmlToBinary (*xml, wrapped);
+            return wrapped;
+        }
+    }
+
+    return state;
+}
+
+juce::MidiMessageSequence loadMidiSequence (const juce::File& file)
+{
+    juce::MidiMessageSequence merged;
+
+    if (! file.existsAsFile())
+        return merged;
+
+    juce::FileInputStream stream (file);
+    juce::MidiFile midiFile;
+
+    if (! stream.openedOk() || ! midiFile.readFrom (stream))
+        return merged;
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+        merged.addSequence (*midiFile.getTrack (track), 0.0);
+
+    merged.sort();
+    return merged;
+}
+
+class RenderJob final : public juce::ThreadPoolJob
+{
+public:
+    RenderJob (juce::File inputToUse, const RenderSettings& settingsToUse)
+        : juce::ThreadPoolJob ("MultiChainer render: " + inputToUse.getFileName()),
+          input (std::move (inputToUse)),
+          settings (settingsToUse)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        juce::String error;
+
+        const auto renderedSamples = render (error);
+
+        if (error.isNotEmpty())
+        {
+            report (input.getFileName() + ": " + error);
+            failed = true;
+            return jobHasFinished;
+        }
+
+        const auto elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+        const auto audioSeconds = static_cast<double> (renderedSamples) / juce::jmax (1.0, renderedSampleRate);
+
+        report (input.getFileName() + ": " + juce::String (audioSeconds, 2) + " s in "
+                + juce::String (elapsedSeconds, 2) + " s ("
+                + juce::String (audioSeconds / juce::jmax (1.0e-9, elapsedSeconds), 1) + "x real time)");
+
+        return jobHasFinished;
+    }
+
+    bool hasFailed() const noexcept { return failed; }
+
+private:
+    static void report (const juce::String& line)
+    {
+        static juce::CriticalSection outputLock;
+        const juce::ScopedLock lock (outputLock);
+        std::cout << line << std::endl;
+    }
+
+    juce::int64 render (juce::String& error)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (input));
+
+        if (reader == nullptr)
+        {
+            error = "unreadable audio file";
+            return 0;
+        }
+
+        const auto sampleRate = reader->sampleRate;
+        const auto blockSize = settings.blockSize;
+        renderedSampleRate = sampleRate;
+
+        auto siblingMidi = input.withFileExtension ("mid");
+        const auto midi = loadMidiSequence (siblingMidi.existsAsFile() ? siblingMidi : settings.midiFile);
+
+        MultiChainerAudioProcessor processor;
+        processor.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        processor.setNonRealtime (true);
+
+        if (settings.state.getSize() > 0)
+            processor.setStateInformation (settings.state.getData(), static_cast<int> (settings.state.getSize()));
+
+        processor.prepareToPlay (sampleRate, blockSize);
+
+        const auto latency = static_cast<juce::int64> (processor.getLatencySamples());
+        const auto outputFile = settings.outputDirectory.getChildFile (input.getFileNameWithoutExtension() + "_ducked.wav");
+
+        outputFile.deleteFile();
+        std::unique_ptr<juce::FileOutputStream> outputStream (outputFile.createOutputStream());
+
+        if (outputStream == nullptr)
+        {
+            error = "cannot create " + outputFile.getFullPathName();
+            return 0;
+        }
+
+        juce::WavAudioFormat wavFormat;
+        const auto bitsPerSample = reader->bitsPerSample > 0 ? static_cast<int> (reader->bitsPerSample) : 24;
+        std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (outputStream.get(),
+                                                                                    sampleRate,
+                                                                                    2,
+                                                                                    bitsPerSample,
+                                                                                    {},
+                                                                                    0));
+
+        if (writer == nullptr)
+        {
+            error = "cannot create WAV writer";
+            return 0;
+        }
+
+        outputStream.release(); // now owned by the writer
+
+        const auto inputLength = reader->lengthInSamples;
+        const auto totalToProcess = inputLength + latency;
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer midiBuffer;
+        int midiIndex = 0;
+
+        for (juce::int64 position = 0; position < totalToProcess; position += blockSize)
+        {
+            const auto numSamples = static_cast<int> (juce::jmin (static_cast<juce::int64> (blockSize), totalToProcess - position));
+            buffer.setSize (2, numSamples, false, false, true);
+            buffer.clear();
+
+            // Past the end of the input the FIR tail is flushed with silence.
+            if (position < inputLength)
+            {
+                const auto toRead = static_cast<int> (juce::jmin (static_cast<juce::int64> (numSamples), inputLength - position));
+                reader->read (&buffer, 0, toRead, position, true, true);
+
+                if (reader->numChannels == 1)
+                    buffer.copyFrom (1, 0, buffer, 0, 0, toRead);
+            }
+
+            midiBuffer.clear();
+
+            for (; midiIndex < midi.getNumEvents(); ++midiIndex)
+            {
+                const auto& message = midi.getEventPointer (midiIndex)->message;
+                const auto samplePosition = static_cast<juce::int64> (std::llround (message.getTimeStamp() * sampleRate));
+
+                if (samplePosition >= position + numSamples)
+                    break;
+
+                midiBuffer.addEvent (message, static_cast<int> (juce::jmax (juce::int64 { 0 }, samplePosition - position)));
+            }
+
+            processor.processBlock (buffer, midiBuffer);
+
+            // Drop the first `latency` output samples so the result lines up with the input.
+            const auto skip = static_cast<int> (juce::jlimit (juce::int64 { 0 }, static_cast<juce::int64> (numSamples), latency - position));
+
+            if (skip < numSamples)
+                writer->writeFromAudioSampleBuffer (buffer, skip, numSamples - skip);
+        }
+
+        processor.releaseResources();
+        return inputLength;
+    }
+
+    const juce::File input;
+    const RenderSettings& settings;
+    double renderedSampleRate = 0.0;
+    bool failed = false;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: MultiChainerRender [--midi <file.mid>] [--state <file>] [--output-dir <dir>]\n"
+                 "                          [--jobs <n>] [--block <samples>] <input.wav>..." << std::endl;
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList arguments (argc, argv);
+
+    if (arguments.size() == 0 || arguments.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return arguments.size() == 0 ? 1 : 0;
+    }
+
+    RenderSettings settings;
+
+    if (arguments.containsOption ("--midi"))
+        settings.midiFile = arguments.getFileForOption ("--midi");
+
+    if (arguments.containsOption ("--state"))
+    {
+        settings.stateFile = arguments.getFileForOption ("--state");
+        settings.state = loadStateFile (settings.stateFile);
+
+        if (settings.state.getSize() == 0)
+        {
+            std::cerr << "Could not read state file" << std::endl;
+            return 1;
+        }
+    }
+
+    settings.outputDirectory = arguments.containsOption ("--output-dir")
+                                   ? arguments.getFileForOption ("--output-dir")
+                                   : juce::File::getCurrentWorkingDirectory();
+    settings.outputDirectory.createDirectory();
+
+    if (arguments.containsOption ("--block"))
+        settings.blockSize = juce::jlimit (16, 8192, arguments.getValueForOption ("--block").getIntValue());
+
+    const auto numJobs = arguments.containsOption ("--jobs")
+                             ? juce::jmax (1, arguments.getValueForOption ("--jobs").getIntValue())
+                             : juce::SystemStats::getNumCpus();
+
+    std::vector<std::unique_ptr<RenderJob>> jobs;
+
+    for (const auto& argument : arguments.arguments)
+    {
+        if (argument.isOption())
+            continue;
+
+        const auto file = argument.resolveAsFile();
+
+        // Skip the values that belong to options, e.g. "--jobs 8".
+        if (! file.existsAsFile() || file == settings.midiFile || file == settings.stateFile || file.hasFileExtension ("mid;midi"))
+            continue;
+
+        jobs.push_back (std::make_unique<RenderJob> (file, settings));
+    }
+
+    if (jobs.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        juce::ThreadPool pool (numJobs);
+
+        for (auto& job : jobs)
+            pool.addJob (job.get(), false);
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep (20);
+    }
+
+    auto failures = 0;
+    for (const auto& job : jobs)
+        failures += job->hasFailed() ? 1 : 0;
+
+    std::cout << jobs.size() << " file(s), " << failures << " failed, "
+              << juce::String ((juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001, 2) << " s total" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
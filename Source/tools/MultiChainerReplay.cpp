@@ -0,0 +1,308 @@
+// Offline replay of a CaptureRecorder capture.
+//
+// Feeds the captured input audio, MIDI, block sizes, parameter snapshots and crossover pairs
+// back through MultiChainerAudioProcessor (built without the editor) with stage profiling on.
+// Every block's output hash is compared with the one recorded in the session, so a report of
+// zero mismatches means the replay reproduced the session bit for bit. The slowest blocks are
+// listed by index, ready to be run again under an external profiler with --repeat.
+//
+//   MultiChainerReplay [--repeat <n>] [--slowest <n>] [--output <file.wav>] <capture>
+//
+// Blocks after a gap (dropped by a full capture ring) start from different DSP state, so
+// mismatches after the first gap are reported separately. Exits non-zero if any block before
+// the first gap differs.
+
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+#include "diagnostics/CaptureRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+using multichainer::diagnostics::CaptureReader;
+using multichainer::diagnostics::CaptureRecorder;
+
+struct BlockTiming
+{
+    int blockIndex = 0;
+    int numSamples = 0;
+    double microseconds = 0.0;
+};
+
+struct ReplayResult
+{
+    juce::String error;
+    int blocks = 0;
+    int mismatchedBlocks = 0;
+    int mismatchedBlocksAfterGap = 0;
+    int firstMismatchBlock = -1;
+    int gaps = 0;
+    uint64_t droppedBlocks = 0;
+    std::vector<BlockTiming> timings;
+};
+
+void printUsage()
+{
+    std::cout << "MultiChainerReplay [--repeat <n>] [--slowest <n>] [--output <file.wav>] <capture>" << std::endl;
+}
+
+ReplayResult replayCapture (const juce::File& captureFile,
+                            MultiChainerAudioProcessor& processor,
+                            juce::AudioFormatWriter* writer)
+{
+    ReplayResult result;
+    CaptureReader reader (captureFile.createInputStream());
+
+    if (! reader.isValid())
+    {
+        result.error = "not a capture file: " + captureFile.getFullPathName();
+        return result;
+    }
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    auto prepared = false;
+
+    for (;;)
+    {
+        const auto next = reader.readNext();
+
+        if (next == CaptureReader::Next::end)
+            break;
+
+        if (next == CaptureReader::Next::corrupt)
+        {
+            result.error = "corrupt record after block " + juce::String (result.blocks);
+            break;
+        }
+
+        if (next == CaptureReader::Next::prepare)
+        {
+            const auto& prepare = reader.getPrepare();
+
+            // Restore the session's bus layout, including any enabled band outputs.
+            auto layout = processor.getBusesLayout();
+
+            for (int bus = 1; bus < layout.outputBuses.size(); ++bus)
+            {
+                layout.outputBuses.getReference (bus) = (prepare.bandOutputMask & (1 << (bus - 1))) != 0
+                                                            ? juce::AudioChannelSet::stereo()
+                                                            : juce::AudioChannelSet::disabled();
+            }
+
+            if (! processor.setBusesLayout (layout))
+            {
+                result.error = "capture uses an unsupported bus layout";
+                break;
+            }
+
+            processor.setRateAndBufferSizeDetails (prepare.sampleRate, prepare.maxBlockSize);
+            processor.prepareToPlay (prepare.sampleRate, prepare.maxBlockSize);
+            prepared = true;
+            continue;
+        }
+
+        if (next == CaptureReader::Next::gap)
+        {
+            ++result.gaps;
+            result.droppedBlocks += reader.getGapDroppedBlocks();
+            continue;
+        }
+
+        if (! prepared)
+        {
+            result.error = "capture has no prepare record";
+            break;
+        }
+
+        auto& block = reader.getBlock();
+        const auto numSamples = block.header.numSamples;
+
+        buffer.setSize (block.header.numChannels, numSamples, false, false, true);
+
+        for (int channel = 0; channel < block.header.numChannels; ++channel)
+            buffer.copyFrom (channel, 0, block.audio, channel, 0, numSamples);
+
+        midi = block.midi;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (! processor.processCapturedBlock (buffer, midi, block.parameters,
+                                              block.header.appliedLowMidHz, block.header.appliedMidHighHz))
+        {
+            result.error = "parameter snapshot size does not match this build";
+            break;
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now() - start).count();
+        result.timings.push_back ({ result.blocks, numSamples, elapsed });
+
+        if (CaptureRecorder::hashAudio (buffer, buffer.getNumChannels(), numSamples) != block.header.outputHash)
+        {
+            if (result.gaps > 0)
+            {
+                ++result.mismatchedBlocksAfterGap;
+            }
+            else
+            {
+                ++result.mismatchedBlocks;
+
+                if (result.firstMismatchBlock < 0)
+                    result.firstMismatchBlock = result.blocks;
+            }
+        }
+
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+
+        ++result.blocks;
+    }
+
+    processor.releaseResources();
+    return result;
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList arguments (argc, argv);
+
+    if (arguments.size() == 0 || arguments.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return arguments.size() == 0 ? 1 : 0;
+    }
+
+    const auto repeat = arguments.containsOption ("--repeat")
+                            ? juce::jmax (1, arguments.getValueForOption ("--repeat").getIntValue())
+                            : 1;
+    const auto slowestToReport = arguments.containsOption ("--slowest")
+                                     ? juce::jmax (0, arguments.getValueForOption ("--slowest").getIntValue())
+                                     : 10;
+    const auto outputFile = arguments.containsOption ("--output") ? arguments.getFileForOption ("--output") : juce::File();
+
+    juce::File captureFile;
+
+    for (const auto& argument : arguments.arguments)
+    {
+        const auto file = argument.resolveAsFile();
+
+        if (! argument.isOption() && file.existsAsFile() && file != outputFile)
+            captureFile = file;
+    }
+
+    if (captureFile == juce::File())
+    {
+        printUsage();
+        return 1;
+    }
+
+    MultiChainerAudioProcessor processor;
+    auto& profiler = processor.getStageProfiler();
+    profiler.addConsumer();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if (outputFile != juce::File())
+    {
+        // The sample rate is only known from the capture's first prepare record.
+        CaptureReader header (captureFile.createInputStream());
+
+        if (header.isValid() && header.readNext() == CaptureReader::Next::prepare)
+        {
+            outputFile.deleteFile();
+
+            if (auto stream = outputFile.createOutputStream())
+            {
+                juce::WavAudioFormat wavFormat;
+                writer.reset (wavFormat.createWriterFor (stream.get(),
+                                                         header.getPrepare().sampleRate,
+                                                         static_cast<unsigned int> (header.getPrepare().numChannels),
+                                                         32,
+                                                         {},
+                                                         0));
+
+                if (writer != nullptr)
+                    stream.release(); // now owned by the writer
+            }
+        }
+
+        if (writer == nullptr)
+        {
+            std::cerr << "Could not create " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    ReplayResult result;
+
+    for (int pass = 0; pass < repeat; ++pass)
+    {
+        auto passResult = replayCapture (captureFile, processor, pass == 0 ? writer.get() : nullptr);
+
+        if (pass == 0)
+        {
+            result = std::move (passResult);
+        }
+        else
+        {
+            // Each pass starts from the capture's prepare record, so passes must agree.
+            result.timings.insert (result.timings.end(), passResult.timings.begin(), passResult.timings.end());
+            result.mismatchedBlocks = juce::jmax (result.mismatchedBlocks, passResult.mismatchedBlocks);
+            result.error = passResult.error;
+        }
+
+        if (result.error.isNotEmpty())
+            break;
+    }
+
+    writer.reset();
+    profiler.removeConsumer();
+
+    std::sort (result.timings.begin(), result.timings.end(), [] (const auto& a, const auto& b)
+    {
+        return a.microseconds > b.microseconds;
+    });
+
+    juce::Array<juce::var> slowest;
+
+    for (size_t index = 0; index < juce::jmin (result.timings.size(), static_cast<size_t> (slowestToReport)); ++index)
+    {
+        const auto& timing = result.timings[index];
+        auto entry = std::make_unique<juce::DynamicObject>();
+        entry->setProperty ("block", timing.blockIndex);
+        entry->setProperty ("numSamples", timing.numSamples);
+        entry->setProperty ("us", timing.microseconds);
+        slowest.add (juce::var (entry.release()));
+    }
+
+    const auto bitIdentical = result.error.isEmpty() && result.mismatchedBlocks == 0;
+
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty ("tool", "MultiChainerReplay");
+    report->setProperty ("version", JUCE_STRINGIFY (MULTICHAINER_VERSION));
+    report->setProperty ("capture", captureFile.getFullPathName());
+
+    if (result.error.isNotEmpty())
+        report->setProperty ("error", result.error);
+
+    report->setProperty ("blocks", result.blocks);
+    report->setProperty ("passes", repeat);
+    report->setProperty ("bitIdentical", bitIdentical);
+    report->setProperty ("mismatchedBlocks", result.mismatchedBlocks);
+    report->setProperty ("firstMismatchBlock", result.firstMismatchBlock);
+    report->setProperty ("gaps", result.gaps);
+    report->setProperty ("droppedBlocks", static_cast<juce::int64> (result.droppedBlocks));
+    report->setProperty ("mismatchedBlocksAfterGap", result.mismatchedBlocksAfterGap);
+    report->setProperty ("slowestBlocks", juce::var (slowest));
+    report->setProperty ("profile", processor.buildProfilingSnapshot());
+
+    std::cout << juce::JSON::toString (juce::var (report.release())) << std::endl;
+    return bitIdentical ? 0 : 1;
+}
@@ -0,0 +1,635 @@
+// Multi-instance scaling stress test.
+//
+// Instantiates N MultiChainerAudioProcessors (built without the editor) and drives them the way
+// a host drives a large session: every render cycle, a pool of M audio threads pulls instances
+// off a shared queue until all N have processed one block, and the cycle must finish within
+// the block's duration. Each instance gets its own input noise, trigger density and crossover
+// setting. The run is repeated for 1, 2, 4, ... up to M threads and the report (JSON) gives, per
+// thread count, throughput, per-core scaling efficiency against one thread, process CPU usage,
+// cycle and per-instance p99 block times and deadline misses, plus resident memory and OS thread
+// counts before and after the instances are created and prepared.
+//
+//   MultiChainerStress [--instances <n>] [--threads <m>] [--block <samples>] [--sample-rate <hz>]
+//                      [--seconds <n>] [--triggers-per-second <n>] [--crossovers <n>]
+//                      [--realtime] [--output <file>]
+//
+// Cycles run back to back by default, which measures capacity; --realtime paces them to the
+// audio clock like a host, which measures CPU load and deadline misses at that session size.
+
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#if JUCE_MAC
+ #include <mach/mach.h>
+ #include <sys/resource.h>
+#elif JUCE_LINUX || JUCE_BSD
+ #include <sys/resource.h>
+ #include <unistd.h>
+#elif JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+ #include <psapi.h>
+ #include <tlhelp32.h>
+#endif
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int numChannels = 2;
+constexpr double warmUpSeconds = 0.5;
+
+struct StressSettings
+{
+    int numInstances = 200;
+    int maxThreads = 4;
+    int blockSize = 256;
+    double sampleRate = 48000.0;
+    double seconds = 10.0;
+    double triggersPerSecond = 4.0;
+    int distinctCrossovers = 8;
+    bool realtime = false;
+};
+
+//==============================================================================
+// Process-wide resource probes. Each returns -1 where the platform gives no answer.
+
+double getProcessCpuSeconds()
+{
+#if JUCE_WINDOWS
+    FILETIME creation, exit, kernel, user;
+
+    if (! GetProcessTimes (GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return -1.0;
+
+    const auto toSeconds = [] (const FILETIME& time)
+    {
+        return static_cast<double> ((static_cast<uint64_t> (time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1.0e-7;
+    };
+
+    return toSeconds (kernel) + toSeconds (user);
+#elif JUCE_MAC || JUCE_LINUX || JUCE_BSD
+    rusage usage {};
+
+    if (getrusage (RUSAGE_SELF, &usage) != 0)
+        return -1.0;
+
+    return static_cast<double> (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+         + static_cast<double> (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1.0e-6;
+#else
+    return -1.0;
+#endif
+}
+
+juce::int64 getResidentBytes()
+{
+#if JUCE_MAC
+    mach_task_basic_info info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info (mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t> (&info), &count) != KERN_SUCCESS)
+        return -1;
+
+    return static_cast<juce::int64> (info.resident_size);
+#elif JUCE_LINUX || JUCE_BSD
+    // Second field of statm is the resident set in pages.
+    const auto fields = juce::StringArray::fromTokens (juce::File ("/proc/self/statm").loadFileAsString(), false);
+
+    if (fields.size() < 2)
+        return -1;
+
+    return fields[1].getLargeIntValue() * static_cast<juce::int64> (sysconf (_SC_PAGESIZE));
+#elif JUCE_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters {};
+
+    if (! K32GetProcessMemoryInfo (GetCurrentProcess(), &counters, sizeof (counters)))
+        return -1;
+
+    return static_cast<juce::int64> (counters.WorkingSetSize);
+#else
+    return -1;
+#endif
+}
+
+int getOsThreadCount()
+{
+#if JUCE_MAC
+    thread_act_array_t threads = nullptr;
+    mach_msg_type_number_t count = 0;
+
+    if (task_threads (mach_task_self(), &threads, &count) != KERN_SUCCESS)
+        return -1;
+
+    for (mach_msg_type_number_t index = 0; index < count; ++index)
+        mach_port_deallocate (mach_task_self(), threads[index]);
+
+    vm_deallocate (mach_task_self(), reinterpret_cast<vm_address_t> (threads), count * sizeof (thread_act_t));
+    return static_cast<int> (count);
+#elif JUCE_LINUX || JUCE_BSD
+    return juce::File ("/proc/self/task").getNumberOfChildFiles (juce::File::findDirectories);
+#elif JUCE_WINDOWS
+    const auto snapshot = CreateToolhelp32Snapshot (TH32CS_SNAPTHREAD, 0);
+
+    if (snapshot == INVALID_HANDLE_VALUE)
+        return -1;
+
+    THREADENTRY32 entry {};
+    entry.dwSize = sizeof (entry);
+    const auto processId = GetCurrentProcessId();
+    int count = 0;
+
+    for (auto found = Thread32First (snapshot, &entry); found; found = Thread32Next (snapshot, &entry))
+        count += entry.th32OwnerProcessID == processId ? 1 : 0;
+
+    CloseHandle (snapshot);
+    return count;
+#else
+    return -1;
+#endif
+}
+
+juce::var sampleResources (const juce::String& label)
+{
+    auto sample = std::make_unique<juce::DynamicObject>();
+    sample->setProperty ("phase", label);
+    sample->setProperty ("rssBytes", getResidentBytes());
+    sample->setProperty ("osThreads", getOsThreadCount());
+    return juce::var (sample.release());
+}
+
+double percentile (std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+        return 0.0;
+
+    const auto index = static_cast<size_t> (juce::jlimit (0.0,
+                                                          static_cast<double> (values.size() - 1),
+                                                          std::ceil (fraction * static_cast<double> (values.size())) - 1.0));
+    std::nth_element (values.begin(), values.begin() + static_cast<std::ptrdiff_t> (index), values.end());
+    return values[index];
+}
+
+//==============================================================================
+// One plugin instance on a simulated track: its processor, the host-side buffers handed to it
+// and its trigger schedule.
+struct Instance
+{
+    MultiChainerAudioProcessor processor;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    int noiseOffset = 0;
+    double samplesPerTrigger = 0.0;
+    double nextTriggerSample = 0.0;
+    juce::int64 blockStartSample = 0;
+};
+
+void setParameter (MultiChainerAudioProcessor& processor, const juce::String& parameterID, float value)
+{
+    if (auto* parameter = processor.getValueTreeState().getParameter (parameterID))
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+}
+
+void configureInstance (Instance& instance, int index, const StressSettings& settings, const juce::AudioBuffer<float>& noise)
+{
+    juce::Random random (0x4d43 + index);
+
+    // A few crossover settings shared across the session, as on real tracks.
+    const auto crossoverIndex = index % juce::jmax (1, settings.distinctCrossovers);
+    setParameter (instance.processor, "crossover.f1", 80.0f + 40.0f * static_cast<float> (crossoverIndex));
+    setParameter (instance.processor, "crossover.f2", 1500.0f + 500.0f * static_cast<float> (crossoverIndex));
+
+    instance.processor.setPlayConfigDetails (numChannels, numChannels, settings.sampleRate, settings.blockSize);
+    instance.processor.prepareToPlay (settings.sampleRate, settings.blockSize);
+
+    instance.buffer.setSize (numChannels, settings.blockSize);
+    instance.midi.ensureSize (256);
+    instance.noiseOffset = random.nextInt (noise.getNumSamples() - settings.blockSize);
+
+    // Densities spread from a quarter to twice the requested rate; some tracks never trigger.
+    if (settings.triggersPerSecond > 0.0 && index % 5 != 4)
+    {
+        const auto rate = settings.triggersPerSecond * (0.25 + 1.75 * random.nextDouble());
+        instance.samplesPerTrigger = settings.sampleRate / rate;
+        instance.nextTriggerSample = random.nextDouble() * instance.samplesPerTrigger;
+    }
+}
+
+void processInstance (Instance& instance, const juce::AudioBuffer<float>& noise, int blockSize) noexcept
+{
+    // The host copies the track's audio into the plugin buffer and fills its MIDI buffer.
+    const auto noiseLength = noise.getNumSamples();
+
+    if (instance.noiseOffset + blockSize > noiseLength)
+        instance.noiseOffset = 0;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        instance.buffer.copyFrom (channel, 0, noise, channel, instance.noiseOffset, blockSize);
+
+    instance.noiseOffset += blockSize;
+    instance.midi.clear();
+
+    if (instance.samplesPerTrigger > 0.0)
+    {
+        const auto blockEnd = static_cast<double> (instance.blockStartSample + blockSize);
+
+        for (; instance.nextTriggerSample < blockEnd; instance.nextTriggerSample += instance.samplesPerTrigger)
+        {
+            const auto offset = static_cast<int> (instance.nextTriggerSample - static_cast<double> (instance.blockStartSample));
+            instance.midi.addEvent (juce::MidiMessage::noteOn (1, 36, static_cast<juce::uint8> (100)), offset);
+        }
+    }
+
+    instance.processor.processBlock (instance.buffer, instance.midi);
+    instance.blockStartSample += blockSize;
+}
+
+//==============================================================================
+// A host-like pool of audio threads. Each cycle releases every worker, which then claim
+// instances from a shared counter until none are left; the cycle ends when all have finished.
+class HostSimulator
+{
+public:
+    HostSimulator (std::vector<std::unique_ptr<Instance>>& instancesToUse,
+                   const juce::AudioBuffer<float>& noiseToUse,
+                   int blockSizeToUse,
+                   int numThreads,
+                   size_t expectedCycles)
+        : instances (instancesToUse),
+          noise (noiseToUse),
+          blockSize (blockSizeToUse)
+    {
+        for (int index = 0; index < numThreads; ++index)
+        {
+            auto& timings = workerBlockNs.emplace_back();
+            timings.reserve (expectedCycles * instances.size() / static_cast<size_t> (numThreads) + instances.size());
+        }
+
+        for (int index = 0; index < numThreads; ++index)
+            workers.emplace_back ([this, index] { workerLoop (static_cast<size_t> (index)); });
+    }
+
+    ~HostSimulator()
+    {
+        {
+            const std::lock_guard<std::mutex> guard (lock);
+            stopping = true;
+        }
+
+        cycleStarted.notify_all();
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    // Runs one render cycle and returns its wall time.
+    double runCycle (bool recordBlocks)
+    {
+        const auto start = Clock::now();
+
+        {
+            const std::lock_guard<std::mutex> guard (lock);
+            nextInstance.store (0, std::memory_order_relaxed);
+            activeWorkers = static_cast<int> (workers.size());
+            recording = recordBlocks;
+            ++generation;
+        }
+
+        cycleStarted.notify_all();
+
+        {
+            std::unique_lock<std::mutex> guard (lock);
+            cycleFinished.wait (guard, [this] { return activeWorkers == 0; });
+        }
+
+        return std::chrono::duration<double, std::nano> (Clock::now() - start).count();
+    }
+
+    std::vector<double> takeBlockTimings()
+    {
+        std::vector<double> merged;
+
+        for (auto& timings : workerBlockNs)
+        {
+            merged.insert (merged.end(), timings.begin(), timings.end());
+            timings.clear();
+        }
+
+        return merged;
+    }
+
+private:
+    void workerLoop (size_t workerIndex)
+    {
+        auto& timings = workerBlockNs[workerIndex];
+        uint64_t seenGeneration = 0;
+
+        for (;;)
+        {
+            bool record = false;
+
+            {
+                std::unique_lock<std::mutex> guard (lock);
+                cycleStarted.wait (guard, [&] { return stopping || generation != seenGeneration; });
+
+                if (stopping)
+                    return;
+
+                seenGeneration = generation;
+                record = recording;
+            }
+
+            for (auto index = nextInstance.fetch_add (1, std::memory_order_relaxed);
+                 index < instances.size();
+                 index = nextInstance.fetch_add (1, std::memory_order_relaxed))
+            {
+                const auto start = Clock::now();
+                processInstance (*instances[index], noise, blockSize);
+
+                if (record)
+                    timings.push_back (std::chrono::duration<double, std::nano> (Clock::now() - start).count());
+            }
+
+            {
+                const std::lock_guard<std::mutex> guard (lock);
+
+                if (--activeWorkers > 0)
+                    continue;
+            }
+
+            cycleFinished.notify_one();
+        }
+    }
+
+    std::vector<std::unique_ptr<Instance>>& instances;
+    const juce::AudioBuffer<float>& noise;
+    const int blockSize;
+
+    std::mutex lock;
+    std::condition_variable cycleStarted;
+    std::condition_variable cycleFinished;
+    uint64_t generation = 0;
+    int activeWorkers = 0;
+    bool recording = false;
+    bool stopping = false;
+
+    std::atomic<size_t> nextInstance { 0 };
+    std::vector<std::vector<double>> workerBlockNs;
+    std::vector<std::thread> workers;
+};
+
+struct ScalingResult
+{
+    int threads = 0;
+    double instanceBlocksPerSecond = 0.0;
+    double realTimeFactor = 0.0;
+    double cpuCores = 0.0;
+    double p50CycleNs = 0.0;
+    double p99CycleNs = 0.0;
+    double maxCycleNs = 0.0;
+    double p99BlockNs = 0.0;
+    double maxBlockNs = 0.0;
+    int deadlineMisses = 0;
+    int cycles = 0;
+};
+
+ScalingResult runScalingStep (std::vector<std::unique_ptr<Instance>>& instances,
+                              const juce::AudioBuffer<float>& noise,
+                              const StressSettings& settings,
+                              int numThreads)
+{
+    const auto periodNs = static_cast<double> (settings.blockSize) / settings.sampleRate * 1.0e9;
+    const auto period = std::chrono::nanoseconds (static_cast<int64_t> (periodNs));
+    const auto warmUpCycles = static_cast<int> (std::ceil (warmUpSeconds * 1.0e9 / periodNs));
+    const auto measuredCycles = juce::jmax (1, static_cast<int> (std::ceil (settings.seconds * 1.0e9 / periodNs)));
+
+    HostSimulator host (instances, noise, settings.blockSize, numThreads, static_cast<size_t> (measuredCycles));
+
+    for (int cycle = 0; cycle < warmUpCycles; ++cycle)
+        host.runCycle (false);
+
+    std::vector<double> cycleNs;
+    cycleNs.reserve (static_cast<size_t> (measuredCycles));
+
+    ScalingResult result;
+    result.threads = numThreads;
+    result.cycles = measuredCycles;
+
+    const auto cpuStart = getProcessCpuSeconds();
+    const auto wallStart = Clock::now();
+    auto nextDeadline = wallStart;
+
+    for (int cycle = 0; cycle < measuredCycles; ++cycle)
+    {
+        if (settings.realtime)
+        {
+            std::this_thread::sleep_until (nextDeadline);
+            nextDeadline += period;
+        }
+
+        const auto elapsed = host.runCycle (true);
+        cycleNs.push_back (elapsed);
+        result.deadlineMisses += elapsed > periodNs ? 1 : 0;
+    }
+
+    const auto wallSeconds = std::chrono::duration<double> (Clock::now() - wallStart).count();
+    const auto cpuEnd = getProcessCpuSeconds();
+
+    auto blockNs = host.takeBlockTimings();
+
+    double busyNs = 0.0;
+    for (auto ns : cycleNs)
+        busyNs += ns;
+
+    result.instanceBlocksPerSecond = static_cast<double> (measuredCycles) * static_cast<double> (instances.size()) / (busyNs * 1.0e-9);
+    result.realTimeFactor = static_cast<double> (measuredCycles) * periodNs / busyNs;
+    result.cpuCores = cpuStart >= 0.0 && cpuEnd >= 0.0 ? (cpuEnd - cpuStart) / wallSeconds : -1.0;
+    result.p50CycleNs = percentile (cycleNs, 0.50);
+    result.p99CycleNs = percentile (cycleNs, 0.99);
+    result.maxCycleNs = *std::max_element (cycleNs.begin(), cycleNs.end());
+    result.p99BlockNs = percentile (blockNs, 0.99);
+    result.maxBlockNs = blockNs.empty() ? 0.0 : *std::max_element (blockNs.begin(), blockNs.end());
+    return result;
+}
+
+std::vector<int> threadCountsUpTo (int maxThreads)
+{
+    std::vector<int> counts;
+
+    for (int count = 1; count < maxThreads; count *= 2)
+        counts.push_back (count);
+
+    counts.push_back (maxThreads);
+    return counts;
+}
+
+void printUsage()
+{
+    std::cout << "Usage: MultiChainerStress [--instances <n>] [--threads <m>] [--block <samples>] [--sample-rate <hz>]\n"
+                 "                          [--seconds <n>] [--triggers-per-second <n>] [--crossovers <n>]\n"
+                 "                          [--realtime] [--output <file>]" << std::endl;
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList arguments (argc, argv);
+
+    if (arguments.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    StressSettings settings;
+    settings.maxThreads = juce::SystemStats::getNumPhysicalCpus();
+
+    if (arguments.containsOption ("--instances"))
+        settings.numInstances = juce::jmax (1, arguments.getValueForOption ("--instances").getIntValue());
+
+    if (arguments.containsOption ("--threads"))
+        settings.maxThreads = juce::jmax (1, arguments.getValueForOption ("--threads").getIntValue());
+
+    if (arguments.containsOption ("--block"))
+        settings.blockSize = juce::jlimit (16, 8192, arguments.getValueForOption ("--block").getIntValue());
+
+    if (arguments.containsOption ("--sample-rate"))
+        settings.sampleRate = juce::jlimit (8000.0, 384000.0, arguments.getValueForOption ("--sample-rate").getDoubleValue());
+
+    if (arguments.containsOption ("--seconds"))
+        settings.seconds = juce::jmax (0.1, arguments.getValueForOption ("--seconds").getDoubleValue());
+
+    if (arguments.containsOption ("--triggers-per-second"))
+        settings.triggersPerSecond = juce::jmax (0.0, arguments.getValueForOption ("--triggers-per-second").getDoubleValue());
+
+    if (arguments.containsOption ("--crossovers"))
+        settings.distinctCrossovers = juce::jlimit (1, 64, arguments.getValueForOption ("--crossovers").getIntValue());
+
+    settings.realtime = arguments.containsOption ("--realtime");
+
+    juce::Array<juce::var> resources;
+    resources.add (sampleResources ("startup"));
+
+    // Two seconds of shared stereo noise; each instance reads it from its own offset.
+    juce::AudioBuffer<float> noise (numChannels, static_cast<int> (settings.sampleRate * 2.0));
+    juce::Random random (0x4d43);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* data = noise.getWritePointer (channel);
+
+        for (int sample = 0; sample < noise.getNumSamples(); ++sample)
+            data[sample] = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+    }
+
+    std::vector<std::unique_ptr<Instance>> instances;
+    instances.reserve (static_cast<size_t> (settings.numInstances));
+
+    const auto constructStart = Clock::now();
+
+    for (int index = 0; index < settings.numInstances; ++index)
+        instances.push_back (std::make_unique<Instance>());
+
+    const auto constructSeconds = std::chrono::duration<double> (Clock::now() - constructStart).count();
+    resources.add (sampleResources ("constructed"));
+
+    const auto prepareStart = Clock::now();
+
+    for (int index = 0; index < settings.numInstances; ++index)
+        configureInstance (*instances[static_cast<size_t> (index)], index, settings, noise);
+
+    const auto prepareSeconds = std::chrono::duration<double> (Clock::now() - prepareStart).count();
+    resources.add (sampleResources ("prepared"));
+
+    juce::Array<juce::var> scaling;
+    double singleThreadThroughput = 0.0;
+
+    for (const auto numThreads : threadCountsUpTo (settings.maxThreads))
+    {
+        const auto result = runScalingStep (instances, noise, settings, numThreads);
+
+        if (numThreads == 1)
+            singleThreadThroughput = result.instanceBlocksPerSecond;
+
+        const auto efficiency = singleThreadThroughput > 0.0
+                                    ? result.instanceBlocksPerSecond / (singleThreadThroughput * numThreads)
+                                    : 0.0;
+
+        auto entry = std::make_unique<juce::DynamicObject>();
+        entry->setProperty ("threads", result.threads);
+        entry->setProperty ("cycles", result.cycles);
+        entry->setProperty ("instanceBlocksPerSecond", result.instanceBlocksPerSecond);
+        entry->setProperty ("realTimeFactor", result.realTimeFactor);
+        entry->setProperty ("scalingEfficiency", efficiency);
+        entry->setProperty ("cpuCores", result.cpuCores);
+        entry->setProperty ("p50CycleNs", result.p50CycleNs);
+        entry->setProperty ("p99CycleNs", result.p99CycleNs);
+        entry->setProperty ("maxCycleNs", result.maxCycleNs);
+        entry->setProperty ("p99BlockNs", result.p99BlockNs);
+        entry->setProperty ("maxBlockNs", result.maxBlockNs);
+        entry->setProperty ("deadlineMisses", result.deadlineMisses);
+        scaling.add (juce::var (entry.release()));
+
+        std::cerr << numThreads << " thread(s): " << juce::String (result.realTimeFactor, 2) << "x real time, "
+                  << juce::String (efficiency * 100.0, 1) << "% scaling efficiency, "
+                  << result.deadlineMisses << " deadline miss(es)" << std::endl;
+    }
+
+    resources.add (sampleResources ("measured"));
+
+    for (auto& instance : instances)
+        instance->processor.releaseResources();
+
+    auto configuration = std::make_unique<juce::DynamicObject>();
+    configuration->setProperty ("instances", settings.numInstances);
+    configuration->setProperty ("maxThreads", settings.maxThreads);
+    configuration->setProperty ("blockSize", settings.blockSize);
+    configuration->setProperty ("sampleRate", settings.sampleRate);
+    configuration->setProperty ("seconds", settings.seconds);
+    configuration->setProperty ("triggersPerSecond", settings.triggersPerSecond);
+    configuration->setProperty ("distinctCrossovers", settings.distinctCrossovers);
+    configuration->setProperty ("realtime", settings.realtime);
+    configuration->setProperty ("latencySamples", instances.front()->processor.getLatencySamples());
+
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty ("tool", "MultiChainerStress");
+    report->setProperty ("version", JUCE_STRINGIFY (MULTICHAINER_VERSION));
+    report->setProperty ("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty ("physicalCores", juce::SystemStats::getNumPhysicalCpus());
+    report->setProperty ("logicalCores", juce::SystemStats::getNumCpus());
+    report->setProperty ("configuration", juce::var (configuration.release()));
+    report->setProperty ("constructSeconds", constructSeconds);
+    report->setProperty ("prepareSeconds", prepareSeconds);
+    report->setProperty ("resources", juce::var (resources));
+    report->setProperty ("scaling", juce::var (scaling));
+
+    const auto json = juce::JSON::toString (juce::var (report.release()));
+
+    if (arguments.containsOption ("--output"))
+    {
+        const auto outputFile = arguments.getFileForOption ("--output");
+
+        if (! outputFile.replaceWithText (json))
+        {
+            std::cerr << "Could not write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
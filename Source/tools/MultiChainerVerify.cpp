@@ -0,0 +1,715 @@
+// Output-equivalence checks for DSP changes.
+//
+//   1. Perfect-reconstruction null tests: with every band depth at 0 dB, the processor output
+//      must equal its input delayed by the reported latency (the DelayCompensator path), and
+//      LinearPhaseCrossover's low + mid + high must equal the same delayed input, across
+//      sample rates, host block sizes, tap counts and crossover automation.
+//      Switching the crossover's economy mode with small host blocks must not add a step to
+//      any band beyond the steady designs' own sample-to-sample change.
+//   2. Golden envelope renders: MultibandDucker gain curves for fixed trigger sequences at
+//      48 kHz, captured once from a reference build (--write-golden) and committed under
+//      Tests/golden, which is also the default --golden directory. Renders are made at several
+//      block sizes, which must all match the one golden file.
+//   3. Envelope bank reference: the same renders must match per-band EnvelopeFollower
+//      instances (the scalar reference for EnvelopeBank) bit for bit. Needs no golden files.
+//   4. Poly voices: Poly Max with two overlapping triggers must equal the per-sample deepest
+//      duck of two EnvelopeFollowers, and Poly Sum must clamp at exactly the full depth.
+//
+//   MultiChainerVerify [--golden <dir>] [--write-golden <dir>]
+//                      [--envelope-tolerance-db <dB>] [--null-tolerance-db <dB>]
+//
+// The envelope bound defaults to bit-exact; pass e.g. --envelope-tolerance-db -120 when
+// checking a backend that is allowed to round differently. Exits non-zero on any failure
+// and prints a JSON report.
+
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+#include "dsp/EnvelopeBank.h"
+#include "dsp/EnvelopeFollower.h"
+#include "dsp/LinearPhaseCrossover.h"
+#include "dsp/MultibandDucker.h"
+#include "dsp/ScratchArena.h"
+
+#include <iostream>
+
+namespace
+{
+using multichainer::dsp::EnvelopeBank;
+using multichainer::dsp::EnvelopeFollower;
+using multichainer::dsp::LinearPhaseCrossover;
+using multichainer::dsp::MultibandDucker;
+
+constexpr int numChannels = 2;
+constexpr double defaultNullToleranceDb = -110.0;
+constexpr double goldenSampleRate = 48000.0;
+
+struct CheckResult
+{
+    juce::String name;
+    bool passed = false;
+    double errorDb = -300.0; // peak absolute error relative to full scale
+    double toleranceDb = 0.0;
+    juce::String note;
+};
+
+double toDb (double linear)
+{
+    return linear > 0.0 ? 20.0 * std::log10 (linear) : -300.0;
+}
+
+void fillNoise (juce::AudioBuffer<float>& buffer, int numSamples, juce::Random& random)
+{
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* data = buffer.getWritePointer (channel);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+            data[sample] = (random.nextFloat() * 2.0f - 1.0f) * 0.5f;
+    }
+}
+
+// Reference delay line kept separate from the DSP under test.
+class ReferenceDelay
+{
+public:
+    explicit ReferenceDelay (int delaySamples)
+        : history (static_cast<size_t> (numChannels), std::vector<float> (static_cast<size_t> (delaySamples), 0.0f))
+    {
+    }
+
+    float process (int channel, float input)
+    {
+        auto& line = history[static_cast<size_t> (channel)];
+
+        if (line.empty())
+            return input;
+
+        const auto output = line[position[static_cast<size_t> (channel)]];
+        line[position[static_cast<size_t> (channel)]] = input;
+        position[static_cast<size_t> (channel)] = (position[static_cast<size_t> (channel)] + 1) % line.size();
+        return output;
+    }
+
+private:
+    std::vector<std::vector<float>> history;
+    std::array<size_t, numChannels> position {};
+};
+
+//==============================================================================
+CheckResult runProcessorNullTest (double sampleRate, int blockSize, bool automateCrossovers, double toleranceDb)
+{
+    CheckResult result;
+    result.name = "processorNull/sr" + juce::String (sampleRate, 0) + "/block" + juce::String (blockSize)
+                  + (automateCrossovers ? "/automated" : "/static");
+    result.toleranceDb = toleranceDb;
+
+    MultiChainerAudioProcessor processor;
+    processor.setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+    processor.setNonRealtime (true);
+
+    for (int band = 1; band <= static_cast<int> (MultibandDucker::numBands); ++band)
+        processor.setParameterFromUI ("band" + juce::String (band) + ".depthDb", 0.0f);
+
+    processor.prepareToPlay (sampleRate, blockSize);
+
+    ReferenceDelay reference (processor.getLatencySamples());
+    juce::Random random (0x6e756c6c);
+    juce::AudioBuffer<float> buffer (numChannels, blockSize);
+    juce::AudioBuffer<float> input (numChannels, blockSize);
+    juce::MidiBuffer midi;
+
+    const auto totalSamples = static_cast<int> (sampleRate * 2.0);
+    double peakError = 0.0;
+
+    for (int position = 0, block = 0; position < totalSamples; position += blockSize, ++block)
+    {
+        fillNoise (input, blockSize, random);
+        buffer.makeCopyOf (input, true);
+
+        midi.clear();
+        if ((block % 7) == 0)
+            midi.addEvent (juce::MidiMessage::noteOn (1, 36, static_cast<juce::uint8> (100)), blockSize / 2);
+
+        if (automateCrossovers)
+        {
+            const auto phase = static_cast<float> (position) / static_cast<float> (totalSamples);
+            processor.setParameterFromUI ("crossover.f1", 100.0f + 600.0f * phase);
+            processor.setParameterFromUI ("crossover.f2", 1500.0f + 6000.0f * phase);
+        }
+
+        processor.processBlock (buffer, midi);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* in = input.getReadPointer (channel);
+            const auto* out = buffer.getReadPointer (channel);
+
+            for (int sample = 0; sample < blockSize; ++sample)
+                peakError = juce::jmax (peakError, static_cast<double> (std::abs (out[sample] - reference.process (channel, in[sample]))));
+        }
+    }
+
+    processor.releaseResources();
+
+    result.errorDb = toDb (peakError);
+    result.passed = result.errorDb <= toleranceDb;
+    return result;
+}
+
+CheckResult runCrossoverNullTest (double sampleRate, int tapCount, int blockSize, double toleranceDb)
+{
+    CheckResult result;
+    result.name = "crossoverNull/sr" + juce::String (sampleRate, 0) + "/taps" + juce::String (tapCount)
+                  + "/block" + juce::String (blockSize);
+    result.toleranceDb = toleranceDb;
+
+    LinearPhaseCrossover crossover (tapCount);
+    crossover.setSynchronousDesign (true);
+    crossover.prepare (sampleRate, blockSize, numChannels);
+    crossover.reset();
+
+    multichainer::dsp::ScratchArena scratchArena;
+    scratchArena.layout ([&crossover] (multichainer::dsp::ScratchArena& arena) { crossover.carveScratch (arena); });
+
+    ReferenceDelay reference (crossover.getLatencySamples());
+    juce::Random random (0x78766572);
+    juce::AudioBuffer<float> input (numChannels, blockSize);
+
+    const auto totalSamples = static_cast<int> (sampleRate);
+    double peakError = 0.0;
+
+    for (int position = 0; position < totalSamples; position += blockSize)
+    {
+        fillNoise (input, blockSize, random);
+
+        const auto phase = static_cast<float> (position) / static_cast<float> (totalSamples);
+        crossover.setTargetFrequencies (60.0f + 900.0f * phase, 2000.0f + 8000.0f * phase);
+        crossover.applyPendingDesign();
+        crossover.process (input, blockSize);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto* in = input.getReadPointer (channel);
+            const auto* low = crossover.getLowBand().getReadPointer (channel);
+            const auto* mid = crossover.getMidBand().getReadPointer (channel);
+            const auto* high = crossover.getHighBand().getReadPointer (channel);
+
+            for (int sample = 0; sample < blockSize; ++sample)
+            {
+                const auto sum = low[sample] + mid[sample] + high[sample];
+                peakError = juce::jmax (peakError, static_cast<double> (std::abs (sum - reference.process (channel, in[sample]))));
+            }
+        }
+    }
+
+    result.errorDb = toDb (peakError);
+    result.passed = result.errorDb <= toleranceDb;
+    return result;
+}
+
+// Largest sample-to-sample step in each band for a 400 Hz sine, which sits in the transition
+// band of the economy low-mid design at the default 200 Hz crossover, so the two qualities give
+// clearly different band levels. With toggleIntervalSamples > 0, economy mode flips on that
+// interval; otherwise it stays at useEconomy throughout.
+std::array<double, LinearPhaseCrossover::numBands> measureBandSteps (double sampleRate, int blockSize, bool useEconomy, int toggleIntervalSamples)
+{
+    LinearPhaseCrossover crossover;
+    crossover.setSynchronousDesign (true);
+    crossover.setEconomyDesignsEnabled (true);
+    crossover.prepare (sampleRate, blockSize, 1);
+    crossover.reset();
+
+    multichainer::dsp::ScratchArena scratchArena;
+    scratchArena.layout ([&crossover] (multichainer::dsp::ScratchArena& arena) { crossover.carveScratch (arena); });
+
+    juce::AudioBuffer<float> input (1, blockSize);
+    std::array<double, LinearPhaseCrossover::numBands> steps {};
+    std::array<float, LinearPhaseCrossover::numBands> previous {};
+
+    const auto totalSamples = static_cast<int> (sampleRate * 1.5);
+    // Skip the start-up transient of the filters.
+    const auto settledSamples = 4 * LinearPhaseCrossover::defaultTapCount;
+    const auto phaseIncrement = juce::MathConstants<double>::twoPi * 400.0 / sampleRate;
+
+    for (int position = 0; position < totalSamples; position += blockSize)
+    {
+        const auto numSamples = juce::jmin (blockSize, totalSamples - position);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+            input.setSample (0, sample, 0.5f * static_cast<float> (std::sin (phaseIncrement * (position + sample))));
+
+        if (toggleIntervalSamples > 0 && position >= settledSamples)
+            useEconomy = ((position - settledSamples) / toggleIntervalSamples) % 2 == 0;
+
+        crossover.applyPendingDesign();
+        crossover.setEconomyMode (useEconomy);
+        crossover.process (input, numSamples);
+
+        const std::array<const float*, LinearPhaseCrossover::numBands> bands { crossover.getLowBand().getReadPointer (0),
+                                                                            crossover.getMidBand().getReadPointer (0),
+                                                                            crossover.getHighBand().getReadPointer (0) };
+
+        for (size_t band = 0; band < bands.size(); ++band)
+        {
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                if (position + sample > settledSamples)
+                    steps[band] = juce::jmax (steps[band], static_cast<double> (std::abs (bands[band][sample] - previous[band])));
+
+                previous[band] = bands[band][sample];
+            }
+        }
+    }
+
+    return steps;
+}
+
+// Switching economy mode with small host blocks must not add a step to any band: its largest
+// sample-to-sample jump stays within 10% of the larger of the two steady qualities'.
+CheckResult runEconomyCrossfadeCheck (double sampleRate, int blockSize)
+{
+    CheckResult result;
+    result.name = "economyCrossfade/sr" + juce::String (sampleRate, 0) + "/block" + juce::String (blockSize);
+    result.toleranceDb = toDb (1.1);
+    result.passed = true;
+
+    const auto standard = measureBandSteps (sampleRate, blockSize, false, 0);
+    const auto economy = measureBandSteps (sampleRate, blockSize, true, 0);
+    const auto switching = measureBandSteps (sampleRate, blockSize, false, static_cast<int> (sampleRate * 0.1) + 7);
+
+    auto worstRatio = 0.0;
+
+    for (size_t band = 0; band < switching.size(); ++band)
+    {
+        const auto steady = juce::jmax (standard[band], economy[band], 1.0e-6);
+        worstRatio = juce::jmax (worstRatio, switching[band] / steady);
+    }
+
+    result.errorDb = toDb (worstRatio);
+    result.passed = result.errorDb <= result.toleranceDb;
+    result.note = "largest step relative to steady economy/standard";
+    return result;
+}
+
+//==============================================================================
+struct EnvelopeScenario
+{
+    juce::String name;
+    std::array<MultibandDucker::BandParameters, MultibandDucker::numBands> bands;
+    double triggerIntervalMs = 250.0;
+    std::vector<double> triggerTimesMs; // used instead of the interval when set
+};
+
+MultibandDucker::BandParameters makeBand (float depthDb, float delayMs, float attackMs, float holdMs, float releaseMs, float curve, float smoothing)
+{
+    MultibandDucker::BandParameters parameters;
+    parameters.depthDb = depthDb;
+    parameters.delayMs = delayMs;
+    parameters.attackMs = attackMs;
+    parameters.holdMs = holdMs;
+    parameters.releaseMs = releaseMs;
+    parameters.curveShape = curve;
+    parameters.smoothing = smoothing;
+    return parameters;
+}
+
+std::vector<EnvelopeScenario> buildEnvelopeScenarios()
+{
+    std::vector<EnvelopeScenario> scenarios;
+
+    EnvelopeScenario defaults;
+    defaults.name = "defaults";
+    defaults.bands.fill (makeBand (12.0f, 0.0f, 20.0f, 30.0f, 180.0f, 1.0f, 0.2f));
+    scenarios.push_back (defaults);
+
+    EnvelopeScenario shaped;
+    shaped.name = "shapedPerBand";
+    shaped.bands = { makeBand (24.0f, 0.0f, 2.0f, 10.0f, 400.0f, 3.0f, 0.0f),
+                     makeBand (6.0f, 12.5f, 40.0f, 0.0f, 90.0f, 0.4f, 0.6f),
+                     makeBand (60.0f, 200.0f, 0.0f, 120.0f, 1500.0f, 10.0f, 0.95f) };
+    shaped.triggerIntervalMs = 700.0;
+    scenarios.push_back (shaped);
+
+    EnvelopeScenario retrigger;
+    retrigger.name = "fastRetrigger";
+    retrigger.bands.fill (makeBand (18.0f, 5.0f, 15.0f, 20.0f, 600.0f, 2.0f, 0.3f));
+    retrigger.triggerIntervalMs = 37.0;
+    scenarios.push_back (retrigger);
+
+    return scenarios;
+}
+
+// Poly Max with two overlapping triggers, checked only against the reference (no golden files).
+EnvelopeScenario buildPolyMaxScenario()
+{
+    auto scenario = buildEnvelopeScenarios()[1];
+    scenario.name = "polyMaxOverlap";
+    scenario.triggerTimesMs = { 0.0, 45.0 };
+
+    for (auto& band : scenario.bands)
+        band.voiceMode = EnvelopeBank::VoiceMode::polyMax;
+
+    return scenario;
+}
+
+std::vector<int> getTriggerSamples (const EnvelopeScenario& scenario, double sampleRate, int totalSamples)
+{
+    std::vector<int> triggers;
+
+    if (! scenario.triggerTimesMs.empty())
+    {
+        for (auto timeMs : scenario.triggerTimesMs)
+            triggers.push_back (static_cast<int> (timeMs * 0.001 * sampleRate));
+
+        return triggers;
+    }
+
+    const auto triggerInterval = scenario.triggerIntervalMs * 0.001 * sampleRate;
+
+    for (double nextTrigger = 0.0; nextTrigger < static_cast<double> (totalSamples); nextTrigger += triggerInterval)
+        triggers.push_back (static_cast<int> (nextTrigger));
+
+    return triggers;
+}
+
+// Renders unity input through the ducker so the band buffers carry the gain curves. Each band's
+// curve is stored whole, one after the other, so the layout does not depend on the block size.
+std::vector<float> renderEnvelopeScenario (const EnvelopeScenario& scenario, double sampleRate, int blockSize)
+{
+    MultibandDucker ducker;
+    ducker.prepare (sampleRate, blockSize, 1);
+    ducker.reset();
+
+    multichainer::dsp::ScratchArena scratchArena;
+    scratchArena.layout ([&ducker] (multichainer::dsp::ScratchArena& arena) { ducker.carveScratch (arena); });
+
+    for (size_t band = 0; band < MultibandDucker::numBands; ++band)
+        ducker.setBandParameters (band, scenario.bands[band]);
+
+    const auto totalSamples = static_cast<int> (sampleRate * 3.0);
+    const auto triggers = getTriggerSamples (scenario, sampleRate, totalSamples);
+    const auto noteOn = juce::MidiMessage::noteOn (1, 36, static_cast<juce::uint8> (100));
+
+    std::vector<float> rendered (static_cast<size_t> (totalSamples) * MultibandDucker::numBands);
+
+    std::array<juce::AudioBuffer<float>, MultibandDucker::numBands> bands;
+    for (auto& band : bands)
+        band.setSize (1, blockSize);
+
+    size_t nextTrigger = 0;
+
+    for (int position = 0; position < totalSamples; position += blockSize)
+    {
+        const auto numSamples = juce::jmin (blockSize, totalSamples - position);
+
+        for (auto& band : bands)
+            juce::FloatVectorOperations::fill (band.getWritePointer (0), 1.0f, numSamples);
+
+        ducker.clearBlockTriggers();
+
+        for (; nextTrigger < triggers.size() && triggers[nextTrigger] < position + numSamples; ++nextTrigger)
+            ducker.pushMidiMessage (noteOn, triggers[nextTrigger] - position, numSamples);
+
+        ducker.processBands (bands[0], bands[1], bands[2], numSamples);
+
+        for (size_t band = 0; band < bands.size(); ++band)
+            std::copy_n (bands[band].getReadPointer (0), numSamples, rendered.data() + band * static_cast<size_t> (totalSamples) + static_cast<size_t> (position));
+    }
+
+    return rendered;
+}
+
+juce::File goldenFileFor (const juce::File& directory, const EnvelopeScenario& scenario, double sampleRate)
+{
+    return directory.getChildFile ("envelope_" + scenario.name + "_" + juce::String (sampleRate, 0) + ".f32");
+}
+
+// Same layout as renderEnvelopeScenario, produced by scalar EnvelopeFollowers: one per band that
+// every trigger restarts, or in Poly Max mode one per trigger, with the deepest duck winning.
+// Poly Sum has no scalar counterpart; see runPolySumClampCheck.
+std::vector<float> renderEnvelopeReference (const EnvelopeScenario& scenario, double sampleRate)
+{
+    const auto totalSamples = static_cast<int> (sampleRate * 3.0);
+    const auto triggers = getTriggerSamples (scenario, sampleRate, totalSamples);
+
+    std::vector<float> rendered (static_cast<size_t> (totalSamples) * MultibandDucker::numBands);
+
+    for (size_t band = 0; band < MultibandDucker::numBands; ++band)
+    {
+        const auto& parameters = scenario.bands[band];
+        const auto polyphonic = parameters.voiceMode != EnvelopeBank::VoiceMode::monoRetrigger;
+        jassert (parameters.voiceMode != EnvelopeBank::VoiceMode::polySum);
+        jassert (! polyphonic || triggers.size() <= EnvelopeBank::numVoices);
+
+        multichainer::dsp::EnvelopeParams envelope;
+        envelope.depthDb = parameters.depthDb;
+        envelope.delayMs = parameters.delayMs;
+        envelope.attackMs = parameters.attackMs;
+        envelope.holdMs = parameters.holdMs;
+        envelope.releaseMs = parameters.releaseMs;
+        envelope.curveShape = parameters.curveShape;
+        envelope.smoothing = parameters.smoothing;
+
+        std::vector<EnvelopeFollower> followers (polyphonic ? triggers.size() : 1);
+
+        for (auto& follower : followers)
+        {
+            follower.prepare (sampleRate);
+            follower.setParameters (envelope);
+        }
+
+        auto* output = rendered.data() + band * static_cast<size_t> (totalSamples);
+        size_t nextTrigger = 0;
+
+        for (int sample = 0; sample < totalSamples; ++sample)
+        {
+            if (! polyphonic)
+            {
+                auto triggered = false;
+
+                for (; nextTrigger < triggers.size() && triggers[nextTrigger] == sample; ++nextTrigger)
+                    triggered = true;
+
+                output[sample] = followers.front().processSample (triggered);
+                continue;
+            }
+
+            // The gain falls as the envelope rises, so the deepest duck is the smallest gain.
+            auto gain = 1.0f;
+
+            for (size_t voice = 0; voice < followers.size(); ++voice)
+                gain = juce::jmin (gain, followers[voice].processSample (triggers[voice] == sample));
+
+            output[sample] = gain;
+        }
+    }
+
+    return rendered;
+}
+
+CheckResult compareRenders (const juce::String& name, const std::vector<float>& rendered, const std::vector<float>& expected, double toleranceDb)
+{
+    CheckResult result;
+    result.name = name;
+    result.toleranceDb = toleranceDb;
+
+    if (expected.size() != rendered.size())
+    {
+        result.note = "length mismatch";
+        return result;
+    }
+
+    double peakError = 0.0;
+    auto bitExact = true;
+
+    for (size_t index = 0; index < rendered.size(); ++index)
+    {
+        bitExact = bitExact && std::memcmp (&expected[index], &rendered[index], sizeof (float)) == 0;
+        peakError = juce::jmax (peakError, static_cast<double> (std::abs (expected[index] - rendered[index])));
+    }
+
+    result.errorDb = toDb (peakError);
+    result.passed = bitExact || (toleranceDb > -300.0 && result.errorDb <= toleranceDb);
+    result.note = bitExact ? "bit-exact" : "differs";
+    return result;
+}
+
+CheckResult compareWithGolden (const juce::String& name, const std::vector<float>& rendered, const juce::File& goldenFile, double toleranceDb)
+{
+    juce::MemoryBlock golden;
+
+    if (! goldenFile.loadFileAsData (golden))
+    {
+        CheckResult result;
+        result.name = name;
+        result.toleranceDb = toleranceDb;
+        result.note = "missing golden file " + goldenFile.getFileName();
+        return result;
+    }
+
+    const auto* samples = static_cast<const float*> (golden.getData());
+    const std::vector<float> expected (samples, samples + golden.getSize() / sizeof (float));
+
+    if (golden.getSize() != expected.size() * sizeof (float))
+    {
+        CheckResult result;
+        result.name = name;
+        result.toleranceDb = toleranceDb;
+        result.note = "length mismatch";
+        return result;
+    }
+
+    return compareRenders (name, rendered, expected, toleranceDb);
+}
+
+// Poly Sum with more overlapping full-depth voices than the depth allows: each band must
+// bottom out at exactly the gain of one voice held at full depth, never below it.
+CheckResult runPolySumClampCheck (double sampleRate, int blockSize)
+{
+    EnvelopeScenario scenario;
+    scenario.name = "polySumClamp";
+    scenario.bands.fill (makeBand (60.0f, 0.0f, 10.0f, 50.0f, 200.0f, 1.0f, 0.0f));
+    scenario.triggerTimesMs = { 0.0 };
+
+    // One voice with no smoothing reaches the full depth during hold.
+    const auto fullDepth = renderEnvelopeReference (scenario, sampleRate);
+
+    scenario.triggerTimesMs = { 0.0, 2.0, 4.0, 6.0 };
+
+    for (auto& band : scenario.bands)
+        band.voiceMode = EnvelopeBank::VoiceMode::polySum;
+
+    const auto rendered = renderEnvelopeScenario (scenario, sampleRate, blockSize);
+    const auto bandLength = rendered.size() / MultibandDucker::numBands;
+
+    CheckResult result;
+    result.name = "envelopePolySumClamp/sr" + juce::String (sampleRate, 0) + "/block" + juce::String (blockSize);
+    result.toleranceDb = -300.0;
+    result.passed = true;
+
+    double peakError = 0.0;
+
+    for (size_t band = 0; band < MultibandDucker::numBands; ++band)
+    {
+        const auto first = static_cast<std::ptrdiff_t> (band * bandLength);
+        const auto last = first + static_cast<std::ptrdiff_t> (bandLength);
+        const auto floor = *std::min_element (fullDepth.begin() + first, fullDepth.begin() + last);
+        const auto lowest = *std::min_element (rendered.begin() + first, rendered.begin() + last);
+
+        peakError = juce::jmax (peakError, static_cast<double> (floor - lowest));
+        result.passed = result.passed && juce::exactlyEqual (lowest, floor);
+    }
+
+    result.errorDb = toDb (peakError);
+    result.note = result.passed ? "clamped at full depth" : (peakError > 0.0 ? "ducks below full depth" : "never reaches full depth");
+    return result;
+}
+
+juce::var toVar (const CheckResult& result)
+{
+    auto object = std::make_unique<juce::DynamicObject>();
+    object->setProperty ("name", result.name);
+    object->setProperty ("passed", result.passed);
+    object->setProperty ("errorDb", result.errorDb);
+    object->setProperty ("toleranceDb", result.toleranceDb);
+
+    if (result.note.isNotEmpty())
+        object->setProperty ("note", result.note);
+
+    return juce::var (object.release());
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ScopedNoDenormals noDenormals;
+
+    juce::ArgumentList arguments (argc, argv);
+
+    const auto nullToleranceDb = arguments.containsOption ("--null-tolerance-db")
+                                     ? arguments.getValueForOption ("--null-tolerance-db").getDoubleValue()
+                                     : defaultNullToleranceDb;
+
+    // -300 dB means "bit-exact only".
+    const auto envelopeToleranceDb = arguments.containsOption ("--envelope-tolerance-db")
+                                         ? arguments.getValueForOption ("--envelope-tolerance-db").getDoubleValue()
+                                         : -300.0;
+
+    const std::vector<double> sampleRates { 44100.0, 48000.0, 96000.0 };
+    const std::vector<int> blockSizes { 1, 64, 500, 2048 };
+
+    std::vector<CheckResult> results;
+
+    for (auto sampleRate : sampleRates)
+    {
+        for (auto blockSize : blockSizes)
+            results.push_back (runProcessorNullTest (sampleRate, blockSize, blockSize == 64, nullToleranceDb));
+
+        for (auto tapCount : { 255, LinearPhaseCrossover::defaultTapCount, 2047 })
+            results.push_back (runCrossoverNullTest (sampleRate, tapCount, 256, nullToleranceDb));
+
+        for (auto blockSize : { 1, 16, 64 })
+            results.push_back (runEconomyCrossfadeCheck (sampleRate, blockSize));
+    }
+
+    const auto writeDirectory = arguments.containsOption ("--write-golden") ? arguments.getFileForOption ("--write-golden") : juce::File();
+#ifdef MULTICHAINER_GOLDEN_DIR
+    const juce::File defaultGoldenDirectory (MULTICHAINER_GOLDEN_DIR);
+#else
+    const auto defaultGoldenDirectory = juce::File::getCurrentWorkingDirectory().getChildFile ("Tests/golden");
+#endif
+    const auto goldenDirectory = arguments.containsOption ("--golden") ? arguments.getFileForOption ("--golden") : defaultGoldenDirectory;
+
+    if (writeDirectory != juce::File())
+        writeDirectory.createDirectory();
+
+    for (const auto& scenario : buildEnvelopeScenarios())
+    {
+        for (auto sampleRate : sampleRates)
+        {
+            for (auto blockSize : blockSizes)
+            {
+                const auto name = "envelopeBankReference/" + scenario.name + "/sr" + juce::String (sampleRate, 0) + "/block" + juce::String (blockSize);
+                results.push_back (compareRenders (name,
+                                                   renderEnvelopeScenario (scenario, sampleRate, blockSize),
+                                                   renderEnvelopeReference (scenario, sampleRate),
+                                                   -300.0));
+            }
+
+            // Golden files are kept to one rate; the reference checks above cover the others.
+            if (! juce::exactlyEqual (sampleRate, goldenSampleRate))
+                continue;
+
+            if (writeDirectory != juce::File())
+            {
+                const auto rendered = renderEnvelopeScenario (scenario, sampleRate, 512);
+                goldenFileFor (writeDirectory, scenario, sampleRate).replaceWithData (rendered.data(), rendered.size() * sizeof (float));
+                continue;
+            }
+
+            for (auto blockSize : blockSizes)
+            {
+                const auto name = "envelopeGolden/" + scenario.name + "/sr" + juce::String (sampleRate, 0) + "/block" + juce::String (blockSize);
+                results.push_back (compareWithGolden (name,
+                                                      renderEnvelopeScenario (scenario, sampleRate, blockSize),
+                                                      goldenFileFor (goldenDirectory, scenario, sampleRate),
+                                                      envelopeToleranceDb));
+            }
+        }
+    }
+
+    const auto polyMax = buildPolyMaxScenario();
+
+    for (auto sampleRate : sampleRates)
+    {
+        for (auto blockSize : blockSizes)
+        {
+            const auto name = "envelopeBankReference/" + polyMax.name + "/sr" + juce::String (sampleRate, 0) + "/block" + juce::String (blockSize);
+            results.push_back (compareRenders (name,
+                                               renderEnvelopeScenario (polyMax, sampleRate, blockSize),
+                                               renderEnvelopeReference (polyMax, sampleRate),
+                                               -300.0));
+            results.push_back (runPolySumClampCheck (sampleRate, blockSize));
+        }
+    }
+
+    juce::Array<juce::var> checks;
+    auto failures = 0;
+
+    for (const auto& result : results)
+    {
+        checks.add (toVar (result));
+        failures += result.passed ? 0 : 1;
+    }
+
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty ("tool", "MultiChainerVerify");
+    report->setProperty ("version", JUCE_STRINGIFY (MULTICHAINER_VERSION));
+    report->setProperty ("failures", failures);
+    report->setProperty ("checks", juce::var (checks));
+
+    std::cout << juce::JSON::toString (juce::var (report.release())) << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+#include "AssetBundle.h"
+
+#include "core/BackgroundWorkerPool.h"
+
+#include <BinaryData.h>
+
+#include <cstring>
+
+namespace multichainer::ui
+{
+const AssetBundle& AssetBundle::getInstance()
+{
+    static const AssetBundle instance;
+    return instance;
+}
+
+void AssetBundle::prewarmAsync()
+{
+    struct PrewarmTask final : public core::BackgroundWorkerPool::Task
+    {
+        PrewarmTask() : Task (core::BackgroundWorkerPool::Priority::low) {}
+        void run() override { getInstance(); }
+    };
+
+    static PrewarmTask task;
+    core::BackgroundWorkerPool::getInstance().schedule (task);
+}
+
+AssetBundle::AssetBundle()
+{
+    juce::MemoryInputStream archiveStream (BinaryData::MultiChainerUI_zip,
+                                           static_cast<size_t> (BinaryData::MultiChainerUI_zipSize),
+                                           false);
+    juce::ZipFile archive (archiveStream);
+
+    for (int index = 0; index < archive.getNumEntries(); ++index)
+    {
+        const auto* entry = archive.getEntry (index);
+
+        if (entry == nullptr || entry->isDirectory)
+            continue;
+
+        std::unique_ptr<juce::InputStream> entryStream (archive.createStreamForEntry (index));
+
+        if (entryStream == nullptr)
+            continue;
+
+        juce::MemoryBlock contents;
+        entryStream->readIntoMemoryBlock (contents);
+
+        Asset asset;
+        asset.data.resize (contents.getSize());
+        std::memcpy (asset.data.data(), contents.getData(), contents.getSize());
+        asset.mimeType = getMimeTypeForPath (entry->filename);
+
+        assets.emplace (entry->filename, std::move (asset));
+    }
+
+    jassert (find ("index.html") != nullptr);
+}
+
+const AssetBundle::Asset* AssetBundle::find (const juce::String& path) const
+{
+    auto normalisedPath = path;
+
+    if (normalisedPath.startsWithChar ('/'))
+        normalisedPath = normalisedPath.fromFirstOccurrenceOf ("/", false, false);
+
+    if (normalisedPath.isEmpty())
+        normalisedPath = "index.html";
+
+    const auto found = assets.find (normalisedPath);
+    return found != assets.end() ? &found->second : nullptr;
+}
+
+juce::String AssetBundle::getMimeTypeForPath (const juce::String& path)
+{
+    if (path.endsWithIgnoreCase (".html"))
+        return "text/html";
+
+    if (path.endsWithIgnoreCase (".css"))
+        return "text/css";
+
+    if (path.endsWithIgnoreCase (".js"))
+        return "text/javascript";
+
+    return "application/octet-stream";
+}
+} // namespace multichainer::ui
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <unordered_map>
+
+namespace multichainer::ui
+{
+// Process-wide, immutable view of the web UI. The build packs Assets/ into one minified,
+// deflated archive (see cmake/BundleAssets.cmake); it is inflated and indexed once, and every
+// editor instance serves its resources from the same decoded copy.
+class AssetBundle
+{
+public:
+    struct Asset
+    {
+        std::vector<std::byte> data;
+        juce::String mimeType;
+    };
+
+    static const AssetBundle& getInstance();
+
+    // Warms the shared instance on a background thread so the first resource request
+    // from a freshly created browser does not pay for decompression.
+    static void prewarmAsync();
+
+    const Asset* find (const juce::String& path) const;
+
+private:
+    AssetBundle();
+
+    static juce::String getMimeTypeForPath (const juce::String& path);
+
+    std::unordered_map<juce::String, Asset> assets;
+};
+} // namespace multichainer::ui
@@ -0,0 +1,35 @@
+#include "UITickDispatcher.h"
+
+namespace multichainer::ui
+{
+UITickDispatcher::~UITickDispatcher()
+{
+    stopTimer();
+}
+
+void UITickDispatcher::addClient (Client& client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    clients.add (&client);
+
+    if (! isTimerRunning())
+        startTimerHz (tickRateHz);
+}
+
+void UITickDispatcher::removeClient (Client& client)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    clients.remove (&client);
+
+    if (clients.isEmpty())
+        stopTimer();
+}
+
+void UITickDispatcher::timerCallback()
+{
+    // ListenerList tolerates clients removing themselves (editor closing) mid-iteration.
+    clients.call ([] (Client& client) { client.handleUITick(); });
+}
+} // namespace multichainer::ui
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace multichainer::ui
+{
+// One 30 Hz message-thread timer shared by every open editor, held through
+// juce::SharedResourcePointer. It runs only while at least one client is registered, so
+// closed editors cost nothing and N open editors cost one timer callback per tick.
+class UITickDispatcher final : private juce::Timer
+{
+public:
+    static constexpr int tickRateHz = 30;
+
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        virtual void handleUITick() = 0;
+    };
+
+    UITickDispatcher() = default;
+    ~UITickDispatcher() override;
+
+    void addClient (Client& client);
+    void removeClient (Client& client);
+
+private:
+    void timerCallback() override;
+
+    juce::ListenerList<Client> clients;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UITickDispatcher)
+};
+} // namespace multichainer::ui
@@ -1,32 +1,13 @@
 #include "WebUIBridge.h"
 
-#include <BinaryData.h>
-
+#include "AssetBundle.h"
 #include "PluginProcessor.h"
-
-#include <cstring>
+#include "diagnostics/TraceRecorder.h"
 
 namespace multichainer::ui
 {
 namespace
 {
-std::optional<juce::WebBrowserComponent::Resource> makeResource (const char* data,
-                                                                 int dataSize,
-                                                                 const juce::String& mimeType)
-{
-    if (data == nullptr || dataSize <= 0)
-        return std::nullopt;
-
-    std::vector<std::byte> bytes (static_cast<size_t> (dataSize));
-    std::memcpy (bytes.data(), data, static_cast<size_t> (dataSize));
-
-    juce::WebBrowserComponent::Resource resource;
-    resource.data = std::move (bytes);
-    resource.mimeType = mimeType;
-
-    return resource;
-}
-
 float varToFloat (const juce::var& value)
 {
     if (value.isDouble() || value.isInt() || value.isInt64() || value.isBool())
@@ -37,7 +18,29 @@ float varToFloat (const juce::var& value)
 } // namespace
 
 WebUIBridge::WebUIBridge (MultiChainerAudioProcessor& processorIn)
-    : processor (processorIn)
+    : processor (processorIn),
+      openedAtMs (juce::Time::getMillisecondCounterHiRes())
+{
+    AssetBundle::prewarmAsync();
+
+    // The analyzer only runs while at least one editor is open.
+    processor.getFFTAnalyzer().addConsumer();
+
+    // The browser is created on the first UI tick rather than here, so the host gets the
+    // editor window back without waiting for the web view to spin up.
+    tickDispatcher->addClient (*this);
+}
+
+WebUIBridge::~WebUIBridge()
+{
+    tickDispatcher->removeClient (*this);
+    flushPendingParameterUpdates();
+    endAllParameterGestures();
+    setDiagnosticsPanelOpen (false);
+    processor.getFFTAnalyzer().removeConsumer();
+}
+
+void WebUIBridge::createBrowser()
 {
     juce::WebBrowserComponent::Options options;
 
@@ -46,9 +49,26 @@ WebUIBridge::WebUIBridge (MultiChainerAudioProcessor& processorIn)
                      {
                          handleParameterChangeEvent (payload);
                      })
+                     .withEventListener ("paramGesture", [this] (const juce::var& payload)
+                     {
+                         handleParameterGestureEvent (payload);
+                     })
                      .withEventListener ("requestState", [this] (const juce::var&)
                      {
                          sendFullStateToFrontend();
+                     })
+                     .withEventListener ("diagnosticsPanel", [this] (const juce::var& payload)
+                     {
+                         if (const auto* object = payload.getDynamicObject())
+                             setDiagnosticsPanelOpen (static_cast<bool> (object->getProperty ("open")));
+                     })
+                     .withEventListener ("resetProfiling", [this] (const juce::var&)
+                     {
+                         processor.getStageProfiler().resetStatistics();
+                     })
+                     .withEventListener ("uiReady", [this] (const juce::var&)
+                     {
+                         handleFirstPaint();
                      });
 
 #if JUCE_WEB_BROWSER_RESOURCE_PROVIDER_AVAILABLE
@@ -57,20 +77,27 @@ WebUIBridge::WebUIBridge (MultiChainerAudioProcessor& processorIn)
 
     browser = std::make_unique<juce::WebBrowserComponent> (options);
     addAndMakeVisible (*browser);
+    resized();
 
 #if JUCE_WEB_BROWSER_RESOURCE_PROVIDER_AVAILABLE
     browser->goToURL (juce::WebBrowserComponent::getResourceProviderRoot());
 #else
     browser->goToURL ("about:blank");
 #endif
-
-    startTimerHz (30);
-    sendFullStateToFrontend();
 }
 
-WebUIBridge::~WebUIBridge()
+void WebUIBridge::handleFirstPaint()
 {
-    stopTimer();
+    if (openToFirstPaintMs >= 0.0)
+        return;
+
+    openToFirstPaintMs = juce::Time::getMillisecondCounterHiRes() - openedAtMs;
+
+#if MULTICHAINER_ENABLE_DEBUG_LOG
+    juce::Logger::writeToLog ("MultiChainer editor open-to-first-paint: " + juce::String (openToFirstPaintMs, 1) + " ms");
+#else
+    DBG ("MultiChainer editor open-to-first-paint: " << openToFirstPaintMs << " ms");
+#endif
 }
 
 void WebUIBridge::resized()
@@ -95,17 +122,14 @@ void WebUIBridge::handleParameterChangeEvent (const juce::var& payload)
     if (object == nullptr)
         return;
 
-    const auto applySingleUpdate = [this] (const juce::var& update)
+    const auto queueSingleUpdate = [this] (const juce::var& update)
     {
         if (const auto* updateObject = update.getDynamicObject())
         {
             const auto parameterID = updateObject->getProperty ("id").toString();
 
             if (parameterID.isNotEmpty())
-            {
-                const auto value = varToFloat (updateObject->getProperty ("value"));
-                processor.setParameterFromUI (parameterID, value);
-            }
+                pendingParameterUpdates[parameterID] = varToFloat (updateObject->getProperty ("value"));
         }
     };
 
@@ -114,13 +138,69 @@ void WebUIBridge::handleParameterChangeEvent (const juce::var& payload)
         if (const auto* updatesArray = object->getProperty ("updates").getArray())
         {
             for (const auto& update : *updatesArray)
-                applySingleUpdate (update);
+                queueSingleUpdate (update);
         }
 
         return;
     }
 
-    applySingleUpdate (payload);
+    queueSingleUpdate (payload);
+}
+
+void WebUIBridge::handleParameterGestureEvent (const juce::var& payload)
+{
+    const auto* object = payload.getDynamicObject();
+
+    if (object == nullptr)
+        return;
+
+    const auto parameterID = object->getProperty ("id").toString();
+    const auto phase = object->getProperty ("phase").toString();
+
+    if (parameterID.isEmpty())
+        return;
+
+    if (phase == "begin")
+    {
+        if (activeGestures.contains (parameterID))
+            return;
+
+        activeGestures.add (parameterID);
+        processor.beginParameterGestureFromUI (parameterID);
+        return;
+    }
+
+    if (phase == "end" && activeGestures.contains (parameterID))
+    {
+        // The final value of the drag must land inside the gesture.
+        flushPendingParameterUpdates();
+
+        activeGestures.removeString (parameterID);
+        processor.endParameterGestureFromUI (parameterID);
+    }
+}
+
+void WebUIBridge::flushPendingParameterUpdates()
+{
+    if (pendingParameterUpdates.empty())
+        return;
+
+    processor.beginParameterBatchFromUI();
+
+    for (const auto& [parameterID, value] : pendingParameterUpdates)
+        processor.setParameterFromUI (parameterID, value, activeGestures.contains (parameterID));
+
+    processor.endParameterBatchFromUI();
+
+    pendingParameterUpdates.clear();
+}
+
+void WebUIBridge::endAllParameterGestures()
+{
+    for (const auto& parameterID : activeGestures)
+        processor.endParameterGestureFromUI (parameterID);
+
+    activeGestures.clear();
 }
 
 void WebUIBridge::pushSpectrumToFrontend()
@@ -151,10 +231,53 @@ void WebUIBridge::pushMidiStatusToFrontend()
     browser->emitEventIfBrowserIsVisible ("midiStatus", processor.buildMidiInputSnapshot());
 }
 
-void WebUIBridge::timerCallback()
+void WebUIBridge::setDiagnosticsPanelOpen (bool shouldBeOpen)
+{
+    if (diagnosticsPanelOpen == shouldBeOpen)
+        return;
+
+    diagnosticsPanelOpen = shouldBeOpen;
+    profilingBroadcastCounter = 0;
+
+    auto& profiler = processor.getStageProfiler();
+
+    if (shouldBeOpen)
+        profiler.addConsumer();
+    else
+        profiler.removeConsumer();
+}
+
+void WebUIBridge::pushProfilingToFrontend()
+{
+    if (browser == nullptr || ! diagnosticsPanelOpen)
+        return;
+
+    // 2 Hz is plenty for a readout and keeps the snapshot off most UI ticks.
+    if (++profilingBroadcastCounter < 15)
+        return;
+
+    profilingBroadcastCounter = 0;
+    browser->emitEventIfBrowserIsVisible ("profiling", processor.buildProfilingSnapshot());
+}
+
+void WebUIBridge::handleUITick()
 {
+    MULTICHAINER_TRACE_THREAD_NAME ("Message");
+    MULTICHAINER_TRACE_SCOPE ("uiTick");
+
+    if (browser == nullptr)
+    {
+        if (isShowing())
+            createBrowser();
+
+        return;
+    }
+
+    flushPendingParameterUpdates();
+
     pushSpectrumToFrontend();
     pushMidiStatusToFrontend();
+    pushProfilingToFrontend();
 
     ++stateBroadcastCounter;
     if (stateBroadcastCounter >= 10)
@@ -166,21 +289,17 @@ void WebUIBridge::timerCallback()
 
 std::optional<juce::WebBrowserComponent::Resource> WebUIBridge::loadAssetResource (const juce::String& path)
 {
-    auto normalisedPath = path;
+    const auto* asset = AssetBundle::getInstance().find (path);
 
-    if (normalisedPath.startsWithChar ('/'))
-        normalisedPath = normalisedPath.fromFirstOccurrenceOf ("/", false, false);
-
-    if (normalisedPath.isEmpty() || normalisedPath == "index.html")
-        return makeResource (BinaryData::index_html, BinaryData::index_htmlSize, "text/html");
-
-    if (normalisedPath == "styles.css")
-        return makeResource (BinaryData::styles_css, BinaryData::styles_cssSize, "text/css");
+    if (asset == nullptr)
+        return std::nullopt;
 
-    if (normalisedPath == "app.js")
-        return makeResource (BinaryData::app_js, BinaryData::app_jsSize, "text/javascript");
+    // Resource owns its bytes, so a single copy out of the shared bundle is unavoidable here.
+    juce::WebBrowserComponent::Resource resource;
+    resource.data = asset->data;
+    resource.mimeType = asset->mimeType;
 
-    return std::nullopt;
+    return resource;
 }
 
 #if JUCE_WEB_BROWSER_RESOURCE_PROVIDER_AVAILABLE
@@ -2,12 +2,16 @@
 
 #include <JuceHeader.h>
 
+#include "UITickDispatcher.h"
+
+#include <map>
+
 class MultiChainerAudioProcessor;
 
 namespace multichainer::ui
 {
 class WebUIBridge final : public juce::Component,
-                          private juce::Timer
+                          private UITickDispatcher::Client
 {
 public:
     explicit WebUIBridge (MultiChainerAudioProcessor& processor);
@@ -17,6 +21,9 @@ public:
 
     void sendFullStateToFrontend();
 
+    // Milliseconds from editor construction to the web UI's first painted frame, or -1 until then.
+    double getOpenToFirstPaintMs() const noexcept { return openToFirstPaintMs; }
+
 private:
     static std::optional<juce::WebBrowserComponent::Resource> loadAssetResource (const juce::String& path);
 
@@ -24,17 +31,35 @@ private:
     static juce::WebBrowserComponent::ResourceProvider createResourceProvider();
 #endif
 
+    void createBrowser();
+    void handleFirstPaint();
+
     void handleParameterChangeEvent (const juce::var& payload);
+    void handleParameterGestureEvent (const juce::var& payload);
+    void flushPendingParameterUpdates();
+    void endAllParameterGestures();
     void pushSpectrumToFrontend();
     void pushMidiStatusToFrontend();
+    void setDiagnosticsPanelOpen (bool shouldBeOpen);
+    void pushProfilingToFrontend();
 
-    void timerCallback() override;
+    void handleUITick() override;
 
     MultiChainerAudioProcessor& processor;
+    juce::SharedResourcePointer<UITickDispatcher> tickDispatcher;
     std::unique_ptr<juce::WebBrowserComponent> browser;
 
+    // Latest value per parameter since the last UI tick; applied as one batch.
+    std::map<juce::String, float> pendingParameterUpdates;
+    juce::StringArray activeGestures;
+
     std::vector<float> fftFrame;
     int stateBroadcastCounter = 0;
+    int profilingBroadcastCounter = 0;
+    bool diagnosticsPanelOpen = false;
+
+    const double openedAtMs;
+    double openToFirstPaintMs = -1.0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WebUIBridge)
 };
@@ -0,0 +1,46 @@
+# Packs the web UI into a single compressed archive that is embedded via BinaryData.
+#
+# Usage:
+#   cmake -DASSET_DIR=<dir> -DSTAGING_DIR=<dir> -DOUTPUT=<file.zip> -DASSETS="a|b|c" -P BundleAssets.cmake
+#
+# Must run with STAGING_DIR as the working directory so archive entries are stored by bare name.
+#
+# Each asset is minified conservatively before being deflated into the zip: CSS block comments,
+# leading/trailing whitespace on every line and blank lines are stripped; JS comments are left
+# alone. The whitespace passes are line-based and do not parse strings, so they also strip
+# indentation and blank lines inside multi-line strings and template literals; keep any whose
+# layout matters (e.g. text shown in <pre>) on a single line.
+
+foreach(required_var ASSET_DIR STAGING_DIR OUTPUT ASSETS)
+    if(NOT DEFINED ${required_var})
+        message(FATAL_ERROR "BundleAssets.cmake: ${required_var} is not set")
+    endif()
+endforeach()
+
+# Assets are '|'-separated so the list survives being passed through add_custom_command.
+string(REPLACE "|" ";" ASSETS "${ASSETS}")
+
+file(MAKE_DIRECTORY "${STAGING_DIR}")
+
+foreach(asset IN LISTS ASSETS)
+    file(READ "${ASSET_DIR}/${asset}" content)
+
+    if(asset MATCHES "\\.css$")
+        string(REGEX REPLACE "/\\*[^*]*\\*+([^/*][^*]*\\*+)*/" "" content "${content}")
+    endif()
+
+    string(REGEX REPLACE "\r\n" "\n" content "${content}")
+    string(REGEX REPLACE "\n[ \t]+" "\n" content "${content}")
+    string(REGEX REPLACE "[ \t]+\n" "\n" content "${content}")
+    string(REGEX REPLACE "\n\n+" "\n" content "${content}")
+    string(REGEX REPLACE "^[ \t\n]+" "" content "${content}")
+
+    file(WRITE "${STAGING_DIR}/${asset}" "${content}")
+endforeach()
+
+# Fixed timestamps keep the archive byte-identical between builds.
+file(ARCHIVE_CREATE
+    OUTPUT "${OUTPUT}"
+    PATHS ${ASSETS}
+    FORMAT zip
+    MTIME "1970-01-01 00:00:00 UTC")